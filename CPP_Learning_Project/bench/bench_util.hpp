@@ -0,0 +1,36 @@
+#pragma once
+
+// what the micro-benchmarks share: they time a few variants of a computation on
+// inputs drawn from the same seeded engine, then print one line per variant
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string_view>
+
+namespace bench {
+
+// every run draws the same inputs
+inline std::mt19937 make_engine()
+{
+    return std::mt19937 { 42 };
+}
+
+// runs fn once, which is expected to perform num_ops operations
+template <typename Fn>
+double time_ns_per_op(const size_t num_ops, Fn&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / num_ops;
+}
+
+// "  label       ns", with the labels aligned
+inline void print_time(const std::string_view label, const double ns)
+{
+    std::cout << "  " << std::left << std::setw(22) << label << std::right << ns << std::endl;
+}
+
+} // namespace bench
@@ -0,0 +1,105 @@
+// checks speed_octant against the acos-based Aircraft::get_speed_octant it replaced,
+// and compares their cost over an array of speeds, one call per speed or in one batch
+
+#include "bench_util.hpp"
+#include "speed_octant.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+constexpr size_t NUM_SPEEDS = 1000000;
+constexpr size_t NUM_ROUNDS = 20;
+constexpr float PI          = 3.14159265f;
+
+// the former implementation
+unsigned int acos_octant(const Point3D& speed)
+{
+    const float speed_len = speed.length();
+    if (speed_len > 0)
+    {
+        const Point3D norm_speed { speed * (1.0f / speed_len) };
+        const float angle =
+            (norm_speed.y() > 0) ? 2.0f * 3.141592f - std::acos(norm_speed.x()) : std::acos(norm_speed.x());
+        return (static_cast<int>(std::round((angle * NUM_AIRCRAFT_TILES) / (2.0f * 3.141592f))) + 1) %
+               NUM_AIRCRAFT_TILES;
+    }
+    return 0;
+}
+
+// whether the speed is too close to a sector bound for the two float computations to agree
+bool on_bound(const Point3D& speed)
+{
+    const double len   = std::sqrt(double(speed.x()) * speed.x() + double(speed.y()) * speed.y() +
+                                   double(speed.z()) * speed.z());
+    const double angle = std::acos(std::clamp(speed.x() / len, -1., 1.)) * 8. / (2. * PI);
+    return std::abs(angle - std::floor(angle) - 0.5) < 1e-4;
+}
+
+int main()
+{
+    auto rengine = bench::make_engine();
+    std::uniform_real_distribution<float> component { -1.f, 1.f };
+
+    // random speeds, then the axes, the diagonals and the null speed
+    std::vector<Point3D> speeds;
+    for (size_t i = 0; i < NUM_SPEEDS; ++i)
+    {
+        speeds.emplace_back(component(rengine), component(rengine), component(rengine) * 0.5f);
+    }
+    for (const float x : { -1.f, 0.f, 1.f })
+    {
+        for (const float y : { -1.f, 0.f, 1.f })
+        {
+            speeds.emplace_back(x, y, 0.f);
+        }
+    }
+
+    size_t mismatches = 0;
+    for (const auto& speed : speeds)
+    {
+        if (speed_octant(speed) != acos_octant(speed) && !on_bound(speed))
+        {
+            if (++mismatches <= 10)
+            {
+                std::cout << "mismatch for " << speed.to_string() << ": " << speed_octant(speed) << " instead of "
+                          << acos_octant(speed) << std::endl;
+            }
+        }
+    }
+
+    std::vector<unsigned char> octants(speeds.size());
+    const auto time_octants = [&](auto octant) {
+        return bench::time_ns_per_op(speeds.size() * NUM_ROUNDS, [&]() {
+            for (size_t round = 0; round < NUM_ROUNDS; ++round)
+            {
+                for (size_t i = 0; i < speeds.size(); ++i)
+                {
+                    octants[i] = static_cast<unsigned char>(octant(speeds[i]));
+                }
+            }
+        });
+    };
+    const auto acos_time    = time_octants(acos_octant);
+    const auto compare_time = time_octants(speed_octant);
+    const auto batch_time   = bench::time_ns_per_op(speeds.size() * NUM_ROUNDS, [&]() {
+        for (size_t round = 0; round < NUM_ROUNDS; ++round)
+        {
+            speed_octants(speeds.data(), octants.data(), speeds.size());
+        }
+    });
+    // the batch gives the same octants as the calls one by one
+    for (size_t i = 0; i < speeds.size(); ++i)
+    {
+        mismatches += octants[i] != speed_octant(speeds[i]);
+    }
+
+    std::cout << speeds.size() << " speeds, " << mismatches << " mismatches, ns per speed:" << std::endl;
+    bench::print_time("acos", acos_time);
+    bench::print_time("speed_octant", compare_time);
+    bench::print_time("speed_octants (batch)", batch_time);
+
+    return mismatches == 0 ? 0 : 1;
+}
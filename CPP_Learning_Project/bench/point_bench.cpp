@@ -0,0 +1,122 @@
+// checks that the Point3D arithmetic and its batch versions (padded SSE or scalar fallback) give
+// the same results, to the bit, as the plain 3-float computations, and compares their cost
+// on the steering and the move of AircraftStore::move_range
+
+#include "bench_util.hpp"
+#include "geometry.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+constexpr size_t NUM_POINTS = 100000;
+constexpr size_t NUM_ROUNDS = 100;
+
+using Plain = std::array<float, 3>;
+
+float plain_length(const Plain& p)
+{
+    return std::sqrt(((0.f + p[0] * p[0]) + p[1] * p[1]) + p[2] * p[2]);
+}
+
+Plain plain_scale(const Plain& p, const float s)
+{
+    return { p[0] * s, p[1] * s, p[2] * s };
+}
+
+Plain plain_cap_length(const Plain& p, const float max_len)
+{
+    const float len = plain_length(p);
+    return len > max_len ? plain_scale(p, max_len / len) : p;
+}
+
+// the speed update of AircraftStore::move_range, without the waypoint look-ahead
+Plain plain_steer(const Plain& pos, const Plain& speed, const Plain& target)
+{
+    const Plain direction = plain_scale({ target[0] - pos[0], target[1] - pos[1], target[2] - pos[2] }, 16.f);
+    const Plain accel     = plain_cap_length({ direction[0] - speed[0], direction[1] - speed[1],
+                                               direction[2] - speed[2] }, 0.5f);
+    return plain_cap_length({ speed[0] + accel[0], speed[1] + accel[1], speed[2] + accel[2] }, 0.7f);
+}
+
+Point3D point_steer(const Point3D& pos, Point3D speed, const Point3D& target)
+{
+    const Point3D direction = (target - pos) * 16.f;
+    return (speed += (direction - speed).cap_length(0.5f)).cap_length(0.7f);
+}
+
+bool same(const Point3D& p, const Plain& q)
+{
+    return std::memcmp(p.values.data(), q.data(), sizeof(Plain)) == 0;
+}
+
+int main()
+{
+    auto rengine = bench::make_engine();
+    std::uniform_real_distribution<float> component { -3.f, 3.f };
+
+    std::vector<Point3D> positions, speeds, targets;
+    std::vector<Plain> plain_positions, plain_speeds, plain_targets;
+    for (size_t i = 0; i < NUM_POINTS; ++i)
+    {
+        for (auto [points, plains] : { std::pair { &positions, &plain_positions }, std::pair { &speeds, &plain_speeds },
+                                       std::pair { &targets, &plain_targets } })
+        {
+            const Plain plain { component(rengine), component(rengine), component(rengine) };
+            points->emplace_back(plain[0], plain[1], plain[2]);
+            plains->emplace_back(plain);
+        }
+    }
+
+    // the batch length goes through the same code as the single one
+    std::vector<float> speed_lengths(NUM_POINTS);
+    lengths(speeds.data(), speed_lengths.data(), NUM_POINTS);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < NUM_POINTS; ++i)
+    {
+        mismatches += speeds[i].length() != plain_length(plain_speeds[i]);
+        mismatches += speed_lengths[i] != plain_length(plain_speeds[i]);
+        mismatches += !same(Point3D { speeds[i] }.cap_length(1.f), plain_cap_length(plain_speeds[i], 1.f));
+        mismatches += !same(point_steer(positions[i], speeds[i], targets[i]),
+                            plain_steer(plain_positions[i], plain_speeds[i], plain_targets[i]));
+    }
+
+    float checksum = 0.f;
+    const auto point_time = bench::time_ns_per_op(NUM_POINTS * NUM_ROUNDS, [&]() {
+        for (size_t round = 0; round < NUM_ROUNDS; ++round)
+        {
+            for (size_t i = 0; i < NUM_POINTS; ++i)
+            {
+                speeds[i] = point_steer(positions[i], speeds[i], targets[i]);
+            }
+            translate(positions.data(), speeds.data(), 0.0625f, NUM_POINTS);
+        }
+        checksum += positions.front().x();
+    });
+    const auto plain_time = bench::time_ns_per_op(NUM_POINTS * NUM_ROUNDS, [&]() {
+        for (size_t round = 0; round < NUM_ROUNDS; ++round)
+        {
+            for (size_t i = 0; i < NUM_POINTS; ++i)
+            {
+                plain_speeds[i] = plain_steer(plain_positions[i], plain_speeds[i], plain_targets[i]);
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    plain_positions[i][c] += plain_speeds[i][c] * 0.0625f;
+                }
+            }
+        }
+        checksum -= plain_positions.front()[0];
+    });
+
+    std::cout << NUM_POINTS << " points (" << (TOWER_SIMD ? "SSE" : "scalar") << "), " << mismatches
+              << " mismatches, ns per steering and move:" << std::endl;
+    bench::print_time("Point3D", point_time);
+    bench::print_time("plain", plain_time);
+
+    // both ran the same computations
+    return mismatches == 0 && checksum == 0.f ? 0 : 1;
+}
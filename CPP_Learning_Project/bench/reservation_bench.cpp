@@ -0,0 +1,98 @@
+// compares the tower's terminal reservations (ReservationTable, indexed by
+// store handle) with the std::map keyed by aircraft address it replaced
+
+#include "bench_util.hpp"
+#include "reservation_table.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr size_t NUM_RESERVATIONS = 10000;
+constexpr size_t NUM_ROUNDS       = 100;
+
+// stands for an aircraft on the heap
+struct Dummy
+{
+    char payload[128];
+};
+
+int main()
+{
+    auto rengine = bench::make_engine();
+
+    std::vector<std::unique_ptr<Dummy>> aircrafts;
+    std::vector<ReservationTable::Handle> handles(NUM_RESERVATIONS);
+    for (size_t i = 0; i < NUM_RESERVATIONS; ++i)
+    {
+        aircrafts.emplace_back(std::make_unique<Dummy>());
+    }
+    std::iota(handles.begin(), handles.end(), 0);
+
+    // lookups come in update order, which has nothing to do with the insertion order
+    std::vector<size_t> order(NUM_RESERVATIONS);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rengine);
+
+    size_t checksum = 0;
+
+    std::map<const Dummy*, size_t> map;
+    // a round empties the container and makes all the reservations again
+    const auto map_fill = bench::time_ns_per_op(NUM_RESERVATIONS * NUM_ROUNDS, [&]() {
+        for (size_t round = 0; round < NUM_ROUNDS; ++round)
+        {
+            map.clear();
+            for (size_t i = 0; i < NUM_RESERVATIONS; ++i)
+            {
+                map.emplace(aircrafts[i].get(), i % 64);
+            }
+        }
+    });
+    const auto map_find = bench::time_ns_per_op(NUM_RESERVATIONS * NUM_ROUNDS, [&]() {
+        for (size_t round = 0; round < NUM_ROUNDS; ++round)
+        {
+            for (const auto i : order)
+            {
+                checksum += map.find(aircrafts[i].get())->second;
+            }
+        }
+    });
+
+    ReservationTable table;
+    const auto table_fill = bench::time_ns_per_op(NUM_RESERVATIONS * NUM_ROUNDS, [&]() {
+        for (size_t round = 0; round < NUM_ROUNDS; ++round)
+        {
+            for (size_t i = 0; table.size() != 0 && i < NUM_RESERVATIONS; ++i)
+            {
+                table.erase(handles[i]);
+            }
+            for (size_t i = 0; i < NUM_RESERVATIONS; ++i)
+            {
+                table.reserve(handles[i], i % 64);
+            }
+        }
+    });
+    const auto table_find = bench::time_ns_per_op(NUM_RESERVATIONS * NUM_ROUNDS, [&]() {
+        for (size_t round = 0; round < NUM_ROUNDS; ++round)
+        {
+            for (const auto i : order)
+            {
+                checksum -= table.find(handles[i]);
+            }
+        }
+    });
+
+    std::cout << NUM_RESERVATIONS << " reservations, ns per operation:" << std::endl;
+    bench::print_time("std::map fill", map_fill);
+    bench::print_time("std::map find", map_find);
+    bench::print_time("ReservationTable fill", table_fill);
+    bench::print_time("ReservationTable find", table_find);
+
+    // both containers hold the same reservations
+    return checksum == 0 ? 0 : 1;
+}
@@ -0,0 +1,322 @@
+// runs the simulation core (no window, no OpenGL) on fixed scenarios, and reports
+// ticks/s, ns per aircraft-tick and heap allocations per tick
+// two runs with the same seed simulate the same thing: only the timings change
+// with --substeps N, every scenario runs a second time with N steps per tick over the
+// same simulated time: the crashes must barely change (the bench fails otherwise)
+// usage: tower_bench [--scenario NAME] [--ticks N] [--threads N] [--seed S] [--substeps N]
+
+#include "aircraft_factory.hpp"
+#include "aircraft_manager.hpp"
+#include "airport.hpp"
+#include "event_log.hpp"
+#include "flight_numbers.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// every allocation of the process is counted, the bench reads the counter around the ticks
+static std::atomic<size_t> num_allocations = 0;
+
+void* operator new(const size_t size)
+{
+    ++num_allocations;
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc {};
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment)
+{
+    ++num_allocations;
+    const auto align = static_cast<size_t>(alignment);
+    if (void* memory = std::aligned_alloc(align, (size + align - 1) / align * align))
+    {
+        return memory;
+    }
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+// standard: fuel drawn as usual
+// circling: full tanks and few terminals, most aircrafts wait in the air for a long time
+// refuel: every aircraft arrives low on fuel, the terminals refill them and the airport orders fuel
+enum class Mix
+{
+    standard,
+    circling,
+    refuel,
+};
+
+struct Scenario
+{
+    std::string_view name;
+    size_t aircrafts;
+    size_t terminals;
+    Mix mix;
+    // measured ticks, after a quarter as many warm-up ticks: the largest fleets get
+    // fewer, to keep every scenario around a second
+    unsigned int ticks;
+};
+
+constexpr std::array<Scenario, 7> SCENARIOS = { {
+    { "1k/10", 1000, 10, Mix::standard, 400 },
+    { "10k/10", 10000, 10, Mix::standard, 100 },
+    { "100k/10", 100000, 10, Mix::standard, 12 },
+    { "1k/1", 1000, 1, Mix::standard, 400 },
+    { "1k/100", 1000, 100, Mix::standard, 400 },
+    { "circling", 10000, 1, Mix::circling, 100 },
+    { "refuel", 1000, 100, Mix::refuel, 400 },
+} };
+// every aircraft alive needs its own flight number
+static_assert(SCENARIOS[2].aircrafts <= flights::COUNT);
+
+struct Options
+{
+    std::string scenario; // all of them if empty
+    unsigned int ticks   = 0; // those of the scenario if 0
+    unsigned int threads = 1;
+    unsigned int seed    = 42;
+    unsigned int substeps = 1; // of the second run, none if 1
+};
+
+struct Result
+{
+    unsigned int ticks    = 0; // steps, with substeps
+    double seconds        = 0.;
+    size_t aircraft_ticks = 0; // sum of the aircrafts alive at each measured tick
+    size_t allocations    = 0;
+    int near_misses       = 0; // the same from one run to the other
+    int crashes           = 0; // about the same whatever the substeps
+};
+
+// the terminals of the one-lane airport, on rows of 10 behind the gateway
+AirportType make_airport_type(const size_t num_terminals)
+{
+    std::vector<Point3D> terminals;
+    for (size_t index = 0; index < num_terminals; ++index)
+    {
+        terminals.emplace_back(.3f - .1f * (index % 10), .3f + .1f * (index / 10), 0.f);
+    }
+    return AirportType { Point3D { -.1f, -.3f, 0.f }, Point3D { -.6f, .3f, 0.f }, std::move(terminals),
+                         { Runway { Point3D { -.5f, -.75f, 0.f } } } };
+}
+
+Result run(const Scenario& scenario, AircraftFactory& factory, const Options& options, const unsigned int substeps)
+{
+    GL::steps_per_sec = DEFAULT_TICKS_PER_SEC * substeps;
+    std::srand(options.seed);
+    factory.seed(options.seed);
+    switch (scenario.mix)
+    {
+    case Mix::standard:
+        factory.set_fuel_range(150.f, GL::max_fuel);
+        break;
+    case Mix::circling:
+        factory.set_fuel_range(.9f * GL::max_fuel, GL::max_fuel);
+        break;
+    case Mix::refuel:
+        factory.set_fuel_range(150.f, LOW_FUEL);
+        break;
+    }
+
+    const auto airport_type = make_airport_type(scenario.terminals);
+    AircraftManager manager;
+    manager.set_num_threads(options.threads);
+    // crashes would shrink the fleet being measured
+    manager.set_collisions(false);
+    manager.get_flight_numbers().seed(options.seed);
+    Airport airport { airport_type, Point3D { 0.f, 0.f, 0.f }, nullptr, manager };
+
+    for (size_t i = 0; i < scenario.aircrafts; ++i)
+    {
+        manager.add_aircraft(factory.create_random_aircraft(airport.get_tower(), manager));
+    }
+
+    // the first ticks hand out the first instructions and grow the buffers
+    const auto ticks = (options.ticks ? options.ticks : scenario.ticks) * substeps;
+    for (unsigned int tick = 0; tick < std::max(1u, ticks / 4); ++tick)
+    {
+        GL::tick(GL::step_delta_time());
+    }
+
+    Result result;
+    result.ticks                  = ticks;
+    const auto allocations_before = num_allocations.load();
+    const auto start              = std::chrono::steady_clock::now();
+    for (unsigned int tick = 0; tick < ticks; ++tick)
+    {
+        result.aircraft_ticks += manager.count_live_aircrafts();
+        GL::tick(GL::step_delta_time());
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.seconds                              = elapsed.count();
+    result.allocations                          = num_allocations.load() - allocations_before;
+    result.near_misses                          = manager.count_near_misses();
+    result.crashes                              = manager.count_crashed_aircrafts();
+    return result;
+}
+
+void print_usage(std::ostream& stream)
+{
+    stream << "usage: tower_bench [--scenario NAME] [--ticks N] [--threads N] [--seed S] [--substeps N]" << std::endl
+           << "scenarios (aircrafts/terminals):";
+    for (const auto& scenario : SCENARIOS)
+    {
+        stream << ' ' << scenario.name;
+    }
+    stream << std::endl;
+}
+
+// the command line is wrong: nothing has run yet
+[[noreturn]] void usage_error(const std::string& message)
+{
+    std::cerr << "error: " << message << std::endl;
+    print_usage(std::cerr);
+    std::exit(EXIT_FAILURE);
+}
+
+int main(int argc, char** argv)
+{
+    using namespace std::string_literals;
+
+    // the value following the option at index i
+    const auto value = [argc, argv](int& i) {
+        if (i + 1 >= argc)
+        {
+            usage_error(std::string { argv[i] } + " needs a value");
+        }
+        return std::string_view { argv[++i] };
+    };
+    // the same, as a whole unsigned number
+    const auto number = [argv, &value](int& i) {
+        const std::string option { argv[i] };
+        const auto text         = value(i);
+        unsigned int result     = 0;
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), result);
+        if (error != std::errc {} || end != text.data() + text.size())
+        {
+            usage_error("invalid value for " + option + ": " + std::string { text });
+        }
+        return result;
+    };
+
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg { argv[i] };
+        if (arg == "--help"s || arg == "-h"s)
+        {
+            print_usage(std::cout);
+            return 0;
+        }
+        else if (arg == "--scenario"s)
+        {
+            options.scenario = value(i);
+        }
+        else if (arg == "--ticks"s)
+        {
+            options.ticks = number(i);
+        }
+        else if (arg == "--threads"s)
+        {
+            options.threads = number(i);
+        }
+        else if (arg == "--seed"s)
+        {
+            options.seed = number(i);
+        }
+        else if (arg == "--substeps"s)
+        {
+            options.substeps = std::max(1u, number(i));
+        }
+        else
+        {
+            usage_error("unknown option " + arg);
+        }
+    }
+    if (!options.scenario.empty() &&
+        std::none_of(SCENARIOS.begin(), SCENARIOS.end(),
+                     [&options](const Scenario& scenario) { return scenario.name == options.scenario; }))
+    {
+        usage_error("unknown scenario " + options.scenario);
+    }
+
+    MediaPath::initialize(argv[0]);
+    GL::headless = true;
+    events::logger.set_verbosity(events::Verbosity::off);
+    AircraftFactory factory;
+    factory.init_aircraft_types();
+
+    std::cout << std::left << std::setw(14) << "scenario" << std::right << std::setw(10) << "aircrafts"
+              << std::setw(8) << "ticks" << std::setw(12) << "ticks/s" << std::setw(18) << "ns/aircraft-tick"
+              << std::setw(14) << "allocs/tick" << std::setw(14) << "near misses" << std::setw(10) << "crashes"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    const auto print = [](const std::string& name, const Result& result) {
+        std::cout << std::left << std::setw(14) << name << std::right << std::setw(10)
+                  << result.aircraft_ticks / result.ticks << std::setw(8) << result.ticks << std::setw(12)
+                  << result.ticks / result.seconds << std::setw(18)
+                  << result.seconds * 1e9 / std::max<size_t>(1, result.aircraft_ticks) << std::setw(14)
+                  << static_cast<double>(result.allocations) / result.ticks << std::setw(14) << result.near_misses
+                  << std::setw(10) << result.crashes << std::endl;
+    };
+
+    bool same_crashes = true;
+    for (const auto& scenario : SCENARIOS)
+    {
+        if (!options.scenario.empty() && scenario.name != options.scenario)
+        {
+            continue;
+        }
+
+        const auto result = run(scenario, factory, options, 1);
+        print(std::string { scenario.name }, result);
+        if (options.substeps > 1)
+        {
+            const auto substepped = run(scenario, factory, options, options.substeps);
+            print(std::string { scenario.name } + " x" + std::to_string(options.substeps), substepped);
+            // the trajectories are integrated differently, which moves a few landings by a
+            // fraction of a tick: one crash in 20 (and at least one) may come or go
+            same_crashes &= std::abs(substepped.crashes - result.crashes) <= std::max(1, result.crashes / 20);
+        }
+    }
+
+    if (!same_crashes)
+    {
+        std::cerr << "The crashes depend on the substeps" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -2,6 +2,7 @@
 
 #include "displayable.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace GL {
@@ -35,4 +36,31 @@ struct disp_z_cmp
 
 inline std::vector<const Displayable*> display_queue;
 
+// sorts values whose first num_sorted elements were sorted at the previous frame:
+// displayables only move a bit between frames, so that prefix is fixed by an insertion
+// sort (linear when nearly sorted), and the new elements are sorted and merged in
+template <typename T, typename Compare>
+void restore_order(std::vector<T>& values, const size_t num_sorted, Compare cmp)
+{
+    for (size_t i = 1; i < num_sorted; ++i)
+    {
+        if (!cmp(values[i], values[i - 1]))
+        {
+            continue;
+        }
+
+        const auto value = values[i];
+        size_t j         = i;
+        for (; j > 0 && cmp(value, values[j - 1]); --j)
+        {
+            values[j] = values[j - 1];
+        }
+        values[j] = value;
+    }
+
+    const auto middle = values.begin() + num_sorted;
+    std::sort(middle, values.end(), cmp);
+    std::inplace_merge(values.begin(), middle, values.end(), cmp);
+}
+
 } // namespace GL
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <unordered_set>
+#include "../profiler.hpp"
+
+#include <vector>
 
 namespace GL {
 
@@ -14,6 +16,18 @@ public:
     virtual bool is_out_of_sim() const = 0;
 };
 
-inline std::unordered_set<DynamicObject*> move_queue;
+// a vector rather than a set: objects move in insertion order, which keeps runs reproducible
+inline std::vector<DynamicObject*> move_queue;
+
+// one step of the simulation
+inline void tick(const float delta_time)
+{
+    PROFILE_SCOPE(tick);
+    for (auto it = move_queue.begin(); it != move_queue.end(); ++it)
+    {
+        auto& dynamic_item = *it;
+        dynamic_item->move(delta_time);
+    }
+}
 
 } // namespace GL
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace GL {
+
+// fixed-timestep scheduler: elapsed (monotonic) time is accumulated and consumed
+// in steps of constant length, so the state of the simulation only depends on
+// the number of steps run, never on how long a frame took
+
+class FixedStepScheduler
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point m_last_time = Clock::now();
+    double m_accumulator          = 0.;
+
+public:
+    void reset()
+    {
+        m_last_time   = Clock::now();
+        m_accumulator = 0.;
+    }
+
+    // returns the number of steps of length step_dt due since the last call,
+    // elapsed time being scaled by speed
+    // at most max_steps (at speed 1, and proportionally more when faster) are returned:
+    // the backlog of a frame that was too slow is dropped instead of snowballing into
+    // the next frames, but a sped up simulation still gets all its steps
+    unsigned int advance(const double step_dt, const float speed, const unsigned int max_steps)
+    {
+        const auto now = Clock::now();
+        m_accumulator += std::chrono::duration<double> { now - m_last_time }.count() * speed;
+        m_last_time = now;
+
+        const auto cap   = static_cast<unsigned int>(std::ceil(max_steps * std::max(speed, 1.f)));
+        const auto due   = static_cast<unsigned int>(std::max(m_accumulator, 0.) / step_dt);
+        const auto steps = std::min(due, cap);
+        m_accumulator    = (steps < due) ? 0. : m_accumulator - steps * step_dt;
+        return steps;
+    }
+};
+
+} // namespace GL
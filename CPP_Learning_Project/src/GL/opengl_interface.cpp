@@ -1,7 +1,24 @@
 #include "opengl_interface.hpp"
 
+#include "../profiler.hpp"
+#include "fixed_step.hpp"
+#include "sprite_batch.hpp"
+#include "texture_atlas.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
 namespace GL {
 
+// held by the simulation thread while it ticks, and by the keystrokes (which run on the
+// GLUT thread but may touch the simulation)
+std::mutex sim_mutex;
+// set by the keystrokes (under sim_mutex): they may zoom or add aircrafts while the
+// simulation is paused, the next frame must be recorded even if no step ran
+bool frame_dirty = false;
+
 void handle_error(const std::string& prefix, const GLenum err)
 {
     if (err != GL_NO_ERROR)
@@ -17,7 +34,9 @@ void keyboard(unsigned char key, int, int)
     const auto iter = keystrokes.find(key);
     if (iter != keystrokes.end())
     {
+        const std::lock_guard lock { sim_mutex };
         (iter->second)();
+        frame_dirty = true;
     }
 }
 
@@ -55,46 +74,113 @@ void reshape_window(int w, int h)
     handle_error("Cannot reshape window");
 }
 
+// the GL side of the sprite batch and the texture atlas, kept out of the simulation core
+static_assert(std::is_same_v<GLuint, unsigned int>);
+
+void SpriteBatch::draw(const unsigned int texture) const
+{
+    if (vertices.empty())
+    {
+        return;
+    }
+
+    glColor3f(1, 1, 1);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, vertices.data());
+    glTexCoordPointer(2, GL_FLOAT, 0, tex_coords.data());
+    glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(vertices.size() / 2));
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+unsigned int TextureAtlas::get_tex_index()
+{
+    if (dirty)
+    {
+        if (tex_index == 0)
+        {
+            glGenTextures(1, &tex_index);
+        }
+        glBindTexture(GL_TEXTURE_2D, tex_index);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        handle_error("Cannot create texture atlas");
+        dirty = false;
+    }
+    return tex_index;
+}
+
+// only draws the last frame published by the simulation thread
 void display(void)
 {
-    // sort the displayables by their z-coordinate
-    std::sort(display_queue.begin(), display_queue.end(), disp_z_cmp {});
+    PROFILE_SCOPE(frame_draw);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
     glOrtho(-zoom, zoom, -zoom, zoom, 0.0f, 1.0f); // left, right, bottom, top, near, far
     glClear(GL_COLOR_BUFFER_BIT);
     glEnable(GL_TEXTURE_2D);
-    for (const auto& item : display_queue)
-    {
-        item->display();
-    }
+    frames.front().draw(atlas.get_tex_index());
+    handle_error("Cannot display sprites");
     glDisable(GL_TEXTURE_2D);
     glutSwapBuffers();
 }
 
-#include <chrono>
-#include <algorithm>
-std::chrono::time_point<std::chrono::_V2::system_clock, std::chrono::_V2::system_clock::duration> current_time;
-void timer(const int step)
+// the displayables draw into the back frame, which is then handed over to display()
+void record_frame()
 {
-    auto start_time = std::chrono::system_clock::now();
-    std::chrono::duration<float> dDelta_time = (start_time - current_time);
-    std::chrono::milliseconds mDelta_time = std::chrono::duration_cast<std::chrono::milliseconds>(dDelta_time);
-
-    float delta_time = mDelta_time.count()/1000.f * sim_speed;
-
-    for(auto it = move_queue.begin(); it != move_queue.end(); ++it)
+    frames.back().clear();
     {
-        auto& dynamic_item = *it;
-        dynamic_item->move(delta_time);
+        PROFILE_SCOPE(frame_sort);
+        // sort the displayables by their z-coordinate (the queue rarely changes between frames)
+        restore_order(display_queue, display_queue.size(), disp_z_cmp {});
     }
+    {
+        PROFILE_SCOPE(frame_record);
+        for (const auto& item : display_queue)
+        {
+            item->display();
+        }
+    }
+    frames.publish();
+}
 
-    current_time = std::chrono::system_clock::now();
+FixedStepScheduler scheduler;
+std::atomic<bool> running = false;
 
+void timer(const int step)
+{
     glutPostRedisplay();
     glutTimerFunc(1000u / ticks_per_sec, timer, step + 1);
 }
 
+// the simulation thread: runs the steps due, then records a frame of the new state
+void simulate()
+{
+    scheduler.reset();
+    while (running)
+    {
+        {
+            const std::lock_guard lock { sim_mutex };
+            const auto steps_per_tick = std::max(1u, steps_per_sec / ticks_per_sec);
+            const auto steps = scheduler.advance(step_delta_time(), sim_speed, max_catch_up_ticks * steps_per_tick);
+            for (unsigned int i = 0; i < steps; ++i)
+            {
+                tick(step_delta_time());
+            }
+            if (steps != 0 || frame_dirty)
+            {
+                record_frame();
+                frame_dirty = false;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::duration<float> { step_delta_time() });
+    }
+}
+
 void init_gl(int argc, char** argv, const char* title)
 {
     glutInit(&argc, argv);
@@ -109,24 +195,56 @@ void init_gl(int argc, char** argv, const char* title)
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glShadeModel(GL_FLAT);
 
+    // let loop() stop the simulation thread when the window is closed
+    glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
     glutKeyboardFunc(keyboard);
     glutDisplayFunc(display);
     glutReshapeFunc(reshape_window);
-
-    current_time = std::chrono::system_clock::now();
+    // from now on, the textures created pack their sprite into the atlas
+    load_sprite = [](const MediaPath& sprite) { return atlas.add(img::Image { sprite.get_full_path() }); };
 
     handle_error("Cannot init OpenGL");
 }
 
 void loop()
 {
+    {
+        // the scene before the first tick
+        const std::lock_guard lock { sim_mutex };
+        record_frame();
+    }
+
+    running = true;
+    std::thread simulation { simulate };
     glutTimerFunc(100, timer, 0);
     glutMainLoop();
+
+    running = false;
+    simulation.join();
+}
+
+unsigned int headless_loop(const unsigned int max_ticks)
+{
+    // without a window there is no timer callback: run the fixed steps as fast as we can
+    unsigned int step = 0;
+    for (running = true; running && (max_ticks == 0 || step < max_ticks); ++step)
+    {
+        tick(step_delta_time());
+    }
+    running = false;
+    return step;
 }
 
 void exit_loop()
 {
-    glutLeaveMainLoop();
+    if (headless)
+    {
+        running = false;
+    }
+    else
+    {
+        glutLeaveMainLoop();
+    }
 }
 
 } // namespace GL
\ No newline at end of file
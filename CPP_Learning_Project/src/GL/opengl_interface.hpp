@@ -1,9 +1,8 @@
 #pragma once
 
-#include "../config.hpp"
-#include "../geometry.hpp"
 #include "displayable.hpp"
 #include "dynamic_object.hpp"
+#include "settings.hpp"
 
 #include <GL/freeglut.h>
 #include <algorithm>
@@ -20,15 +19,6 @@
 
 namespace GL {
 
-inline unsigned int ticks_per_sec = DEFAULT_TICKS_PER_SEC;
-inline float zoom                 = DEFAULT_ZOOM;
-inline bool fullscreen            = false;
-
-inline float sim_speed            = 1.f;
-
-inline float max_fuel             = 3000.f;
-inline float max_truck_load       = 5000.f;
-
 using KeyStroke = std::function<void(void)>;
 
 inline std::unordered_map<char, KeyStroke> keystrokes;
@@ -39,6 +29,8 @@ void toggle_fullscreen();
 void change_zoom(const float factor);
 void init_gl(int argc, char** argv, const char* title);
 void loop();
+// runs max_ticks fixed steps (0 = until exit_loop()), returns the number of steps run
+unsigned int headless_loop(const unsigned int max_ticks);
 void exit_loop();
 
 } // namespace GL
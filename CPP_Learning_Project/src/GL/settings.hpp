@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../config.hpp"
+#include "../geometry.hpp"
+
+#include <cmath>
+
+// settings shared by the simulation and the display: nothing here talks to OpenGL,
+// so that the simulation core builds without it (see opengl_interface.hpp for the rest)
+
+namespace GL {
+
+inline unsigned int ticks_per_sec = DEFAULT_TICKS_PER_SEC;
+inline float zoom                 = DEFAULT_ZOOM;
+inline bool fullscreen            = false;
+// no window, no textures: the move queue is driven by headless_loop()
+inline bool headless              = false;
+
+inline float sim_speed            = 1.f;
+// the simulation advances in fixed steps, independently from the display rate
+inline unsigned int steps_per_sec      = DEFAULT_TICKS_PER_SEC;
+inline unsigned int max_catch_up_ticks = DEFAULT_MAX_CATCH_UP_TICKS;
+
+inline float step_delta_time() { return 1.f / steps_per_sec; }
+
+inline float max_fuel             = 3000.f;
+inline float max_truck_load       = 5000.f;
+
+// whether a sprite centered on pos overlaps the glOrtho(-zoom, zoom, -zoom, zoom) box
+inline bool is_on_screen(const Point2D& pos, const Point2D& dim)
+{
+    return std::abs(pos.x()) - dim.x() * 0.5f < zoom && std::abs(pos.y()) - dim.y() * 0.5f < zoom;
+}
+
+} // namespace GL
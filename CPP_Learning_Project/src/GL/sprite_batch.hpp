@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../geometry.hpp"
+#include "triple_buffer.hpp"
+
+#include <vector>
+
+namespace GL {
+
+// textured quads are not drawn right away: they are collected into client-side vertex
+// and texcoord arrays, which are submitted with a single glDrawArrays
+// (the GL side, draw(), lives in opengl_interface.cpp)
+// all sprites live in the texture atlas, quads are drawn in the order they were added
+class SpriteBatch
+{
+public:
+    // (u0, v0) and (u1, v1) are the texture coordinates of the top left and bottom right corners
+    void add(const Point2D& pos, const Point2D& dim, const float u0, const float v0, const float u1, const float v1)
+    {
+        const float left   = pos.x() - dim.x() * 0.5f;
+        const float right  = pos.x() + dim.x() * 0.5f;
+        const float bottom = pos.y() - dim.y() * 0.5f;
+        const float top    = pos.y() + dim.y() * 0.5f;
+
+        vertices.insert(vertices.end(), { left, top, right, top, right, bottom, left, bottom });
+        tex_coords.insert(tex_coords.end(), { u0, v0, u1, v0, u1, v1, u0, v1 });
+    }
+
+    // the buffers are kept for the next frame
+    void clear()
+    {
+        vertices.clear();
+        tex_coords.clear();
+    }
+
+    // binds texture (GLuint)
+    void draw(const unsigned int texture) const;
+
+private:
+    std::vector<float> vertices;   // 4 (x, y) per quad
+    std::vector<float> tex_coords; // 4 (u, v) per quad
+};
+
+// snapshots of the scene: the simulation thread records a frame after its ticks
+// (the displayables draw into frames.back()), display() draws frames.front()
+inline TripleBuffer<SpriteBatch> frames;
+
+} // namespace GL
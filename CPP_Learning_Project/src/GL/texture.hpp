@@ -1,94 +1,53 @@
 #pragma once
 
-#include "../img/image.hpp"
-#include "opengl_interface.hpp"
-
-#include <GL/glut.h>
-#include <array>
-#include <cassert>
+#include "../img/media_path.hpp"
+#include "settings.hpp"
+#include "sprite_batch.hpp"
 
 namespace GL {
 
-inline GLuint init_texture(const img::Image* image)
+// texture coordinates of a sprite within the texture atlas
+struct TextureRegion
 {
-    static_assert(sizeof(decltype(*image->get_data())) == sizeof(GLubyte));
+    float u0 = 0.f;
+    float v0 = 0.f;
+    float u1 = 0.f;
+    float v1 = 0.f;
+};
 
-    GLuint tex_index;
-    assert(image);
-    glGenTextures(1, &tex_index);
-    glBindTexture(GL_TEXTURE_2D, tex_index);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, image->get_pixel_size(), image->get_width(), image->get_height(), 0,
-                 image->has_alpha() ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, image->get_data());
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    handle_error("Cannot create texture");
-    return tex_index;
-}
+// loads a sprite and packs it into the texture atlas: set by init_gl (see opengl_interface.cpp),
+// so that the simulation core never touches an image, and left unset by headless runs
+inline TextureRegion (*load_sprite)(const MediaPath& sprite) = nullptr;
 
+// a sprite (or a strip of num_tiles sprites) packed in the texture atlas
 class Texture2D
 {
 protected:
-    const img::Image* image = nullptr;
-    GLuint tex_index        = 0;
-    float tile_width        = 0.f;
+    TextureRegion region;
+    float tile_width = 0.f;
 
 public:
-    Texture2D(const img::Image* image_, const size_t num_tiles = 1) :
-        image { image_ }, tex_index { init_texture(image) }, tile_width { 1.0f / num_tiles }
+    // without a sprite or a loader, the texture is never packed
+    Texture2D(const MediaPath* sprite, const size_t num_tiles = 1) :
+        region { sprite && load_sprite ? load_sprite(*sprite) : TextureRegion {} },
+        tile_width { (region.u1 - region.u0) / num_tiles }
     {}
 
     Texture2D(const Texture2D&) = delete;
     Texture2D& operator=(const Texture2D&) = delete;
 
-    ~Texture2D() { glDeleteTextures(1, &tex_index); }
-
-    void draw(Point2D pos, const Point2D& dim, const size_t tile_idx = 0) const
-    {
-        glBindTexture(GL_TEXTURE_2D, tex_index);
-        glColor3f(1, 1, 1);
-
-        glBegin(GL_QUADS);
-        draw_point(TopLeft, pos, dim, tile_idx);
-        draw_point(TopRight, pos, dim, tile_idx);
-        draw_point(BottomRight, pos, dim, tile_idx);
-        draw_point(BottomLeft, pos, dim, tile_idx);
-        glEnd();
-
-        handle_error("Cannot display texture");
-    }
-
-    const img::Image& get_image() const { return *image; }
-
-private:
-    enum Coordinate
+    // recorded in the frame being built by the simulation thread (see GL::frames)
+    // sprites out of the screen are dropped right away
+    void draw(const Point2D& pos, const Point2D& dim, const size_t tile_idx = 0) const
     {
-        TopLeft,
-        TopRight,
-        BottomLeft,
-        BottomRight,
-        Count,
-    };
-
-    static inline const std::array<Point2D, Coordinate::Count> _texture_shifts {
-        Point2D { 0.f, 0.f }, Point2D { 1.f, 0.f }, Point2D { 0.f, 1.f }, Point2D { 1.f, 1.f }
-    };
-
-    static inline const std::array<Point2D, Coordinate::Count> _screen_shifts {
-        Point2D { -1.f, 1.f }, Point2D { 1.f, 1.f }, Point2D { -1.f, -1.f }, Point2D { 1.f, -1.f }
-    };
-
-    void draw_point(Coordinate coordinate, const Point2D& screen_pos, const Point2D& screen_dim,
-                    const size_t tile_idx) const
-    {
-        const auto& tex_shift    = _texture_shifts[coordinate];
-        const auto& screen_shift = _screen_shifts[coordinate];
-
-        glTexCoord2f((tile_idx + tex_shift.x()) * tile_width, tex_shift.y());
+        if (!is_on_screen(pos, dim))
+        {
+            return;
+        }
 
-        const auto vertex = screen_pos + screen_dim * screen_shift * 0.5f;
-        glVertex2fv(vertex.values.data());
+        const float u0 = region.u0 + tile_idx * tile_width;
+        frames.back().add(pos, dim, u0, region.v0, u0 + tile_width, region.v1);
     }
 };
 
-} // namespace GL
\ No newline at end of file
+} // namespace GL
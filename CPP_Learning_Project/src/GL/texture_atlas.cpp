@@ -0,0 +1,63 @@
+#include "texture_atlas.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace GL {
+
+TextureAtlas::Region TextureAtlas::add(const img::Image& image)
+{
+    const auto image_width  = image.get_width();
+    const auto image_height = image.get_height();
+
+    if (shelf_x + image_width > width)
+    {
+        shelf_x = 0u;
+        shelf_y += shelf_height + PADDING;
+        shelf_height = 0u;
+    }
+    if (image_width > width || shelf_y + image_height > height)
+    {
+        throw std::runtime_error { "Texture atlas is full" };
+    }
+
+    if (pixels.empty())
+    {
+        pixels.resize(width * height * 4, 0);
+    }
+
+    // converted to RGBA on the way (the sprites are grey, RGB or RGBA)
+    const auto pixel_size = image.get_pixel_size();
+    const auto* data      = image.get_data();
+    for (unsigned int y = 0; y < image_height; ++y)
+    {
+        for (unsigned int x = 0; x < image_width; ++x)
+        {
+            const auto* src = data + (y * image_width + x) * pixel_size;
+            auto* dst       = pixels.data() + ((shelf_y + y) * width + shelf_x + x) * 4;
+            if (pixel_size >= 3)
+            {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = pixel_size == 4 ? src[3] : 255;
+            }
+            else
+            {
+                dst[0] = dst[1] = dst[2] = src[0];
+                dst[3]                   = pixel_size == 2 ? src[1] : 255;
+            }
+        }
+    }
+
+    const Region region { static_cast<float>(shelf_x) / width, static_cast<float>(shelf_y) / height,
+                          static_cast<float>(shelf_x + image_width) / width,
+                          static_cast<float>(shelf_y + image_height) / height };
+
+    shelf_x += image_width + PADDING;
+    shelf_height = std::max(shelf_height, image_height);
+    dirty        = true;
+    return region;
+}
+
+} // namespace GL
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../config.hpp"
+#include "../img/image.hpp"
+#include "texture.hpp"
+
+#include <vector>
+
+namespace GL {
+
+// every texture is packed into a single RGBA texture, so that the sprite batch can
+// draw all sprites with one bind
+// images are laid out left to right on shelves as high as their tallest image, with
+// a pixel of padding so that linear filtering does not bleed between them
+class TextureAtlas
+{
+public:
+    using Region = TextureRegion;
+
+    TextureAtlas(const unsigned int width_, const unsigned int height_) : width { width_ }, height { height_ } {}
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // copies the image into the atlas (throws if it does not fit)
+    Region add(const img::Image& image);
+
+    // uploads the images added since the last call first (needs a GL context, defined
+    // with the rest of the GL side in opengl_interface.cpp)
+    unsigned int get_tex_index();
+
+private:
+    static constexpr unsigned int PADDING = 1u;
+
+    const unsigned int width;
+    const unsigned int height;
+    // allocated by the first image: headless runs never get one
+    std::vector<unsigned char> pixels;
+
+    unsigned int shelf_x      = 0u;
+    unsigned int shelf_y      = 0u;
+    unsigned int shelf_height = 0u;
+
+    // the texture lives as long as the GL context, it is never deleted
+    unsigned int tex_index = 0; // GLuint
+    bool dirty             = false;
+};
+
+inline TextureAtlas atlas { TEXTURE_ATLAS_SIZE, TEXTURE_ATLAS_SIZE };
+
+} // namespace GL
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace GL {
+
+// lock-free triple buffer between one writer and one reader thread: the writer fills
+// the back buffer and publishes it, the reader always gets the latest published one
+// neither side ever waits, and a buffer is never accessed by both at the same time
+
+template <typename T> class TripleBuffer
+{
+public:
+    // writer side
+    T& back() { return m_buffers[m_back]; }
+    void publish() { m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX; }
+
+    // reader side: the same buffer as last time if nothing was published since
+    const T& front()
+    {
+        if (m_middle.load(std::memory_order_relaxed) & FRESH)
+        {
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+        }
+        return m_buffers[m_front];
+    }
+
+private:
+    static constexpr unsigned int INDEX = 3u;
+    static constexpr unsigned int FRESH = 4u;
+
+    std::array<T, 3> m_buffers;
+    unsigned int m_back = 0u;
+    // index of the buffer in between, FRESH if published and not read yet
+    std::atomic<unsigned int> m_middle = 1u;
+    unsigned int m_front               = 2u;
+};
+
+} // namespace GL
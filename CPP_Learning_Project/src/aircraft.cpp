@@ -1,43 +1,11 @@
 #include "aircraft.hpp"
 
-void Aircraft::turn_to_waypoint(double delta_time)
-{
-    if (!m_waypoints.empty())
-    {
-        Point3D target = m_waypoints[0];
-        if (m_waypoints.size() > 1)
-        {
-            const float d   = (m_waypoints[0] - m_pos).length();
-            const Point3D W = (m_waypoints[0] - m_waypoints[1]).normalize(d / 2.0f);
-            target += W;
-        }
-
-        Point3D direction = (target - m_pos)*(1.f/delta_time);
-        turn(direction - m_speed);
-    }
-}
-
-void Aircraft::turn(Point3D direction)
-{
-    (m_speed += direction.cap_length(m_type.max_accel)).cap_length(max_speed());
-}
+#include "event_log.hpp"
+#include "speed_octant.hpp"
 
 unsigned int Aircraft::get_speed_octant() const
 {
-    const float speed_len = m_speed.length();
-    if (speed_len > 0)
-    {
-        const Point3D norm_speed { m_speed * (1.0f / speed_len) };
-        const float angle =
-            (norm_speed.y() > 0) ? 2.0f * 3.141592f - std::acos(norm_speed.x()) : std::acos(norm_speed.x());
-        // partition into NUM_AIRCRAFT_TILES equal pieces
-        return (static_cast<int>(std::round((angle * NUM_AIRCRAFT_TILES) / (2.0f * 3.141592f))) + 1) %
-               NUM_AIRCRAFT_TILES;
-    }
-    else
-    {
-        return 0;
-    }
+    return speed_octant(speed());
 }
 
 // when we arrive at a terminal, signal the tower
@@ -45,8 +13,8 @@ void Aircraft::arrive_at_terminal()
 {
     // we arrived at a terminal, so start servicing
     m_control.arrived_at_terminal(*this);
-    m_is_at_terminal = true;
-    m_has_landed = true;
+    set(AircraftStore::at_terminal, true);
+    set(AircraftStore::landed, true);
 }
 
 // deploy and retract landing gear depending on next waypoints
@@ -60,110 +28,91 @@ void Aircraft::operate_landing_gear()
         // deploy/retract landing gear when landing/lifting-off
         if (ground_before && !ground_after)
         {
-            std::cout << m_flight_number << " lift off" << std::endl;
+            events::logger.log(events::Kind::lift_off, m_flight_id, pos());
         }
         else if (!ground_before && ground_after)
         {
-            std::cout << m_flight_number << " is now landing..." << std::endl;
-            m_landing_gear_deployed = true;
+            events::logger.log(events::Kind::landing, m_flight_id, pos());
+            set(AircraftStore::landing_gear_deployed, true);
         }
         else if (!ground_before && !ground_after)
         {
-            m_landing_gear_deployed = false;
+            set(AircraftStore::landing_gear_deployed, false);
         }
     }
 }
 
-template <bool front>
-void Aircraft::add_waypoint(const Waypoint& wp)
+void Aircraft::sync_waypoints()
 {
-    if constexpr (front)
-    {
-        m_waypoints.push_front(wp);
-    }
-    else
-    {
-        m_waypoints.push_back(wp);
-    }
+    const auto size = m_waypoints.size();
+    m_store.set_waypoints(m_handle, size > 0 ? &m_waypoints[0] : nullptr, size > 1 ? &m_waypoints[1] : nullptr);
 }
 
-void Aircraft::move(double delta_time)
+CrashReason Aircraft::update_waypoints()
 {
-    m_fuel -= 0.5f;
-    if(m_fuel <= 0.f)
+    if(get_fuel() <= 0.f)
     {
-        throw AircraftCrash { m_flight_number, m_pos, m_speed, "out of fuel" };
+        return CrashReason::out_of_fuel;
     }
 
     if (m_waypoints.empty())
     {
         if(is_out_of_sim())
         {
-            return;
-        }
-        // waypoints = control.get_instructions(*this);
-        // auto front = false;
-        for (const auto& wp: m_control.get_instructions(*this))
-        {
-            add_waypoint<false>(wp);
+            return CrashReason::none;
         }
+        m_waypoints = m_control.get_instructions(*this);
     }
 
-    if (!m_is_at_terminal)
+    if (!is_at_terminal() && is_circling())
     {
-        if(is_circling())
+        auto path = m_control.reserve_terminal(*this);
+        if(!path.empty())
         {
-            auto path = m_control.reserve_terminal(*this);
-            if(!path.empty())
-            {
-                m_waypoints = std::move(path);
-            }    
+            m_waypoints = std::move(path);
         }
+    }
 
-        turn_to_waypoint(delta_time);
-        // move in the direction of the current speed
-        m_pos += m_speed * delta_time;
+    sync_waypoints();
+    return CrashReason::none;
+}
 
-        // if we are close to our next waypoint, stike if off the list
-        if (!m_waypoints.empty() && distance_to(m_waypoints.front()) < DISTANCE_THRESHOLD)
-        {
-            if (m_waypoints.front().is_at_terminal())
-            {
-                arrive_at_terminal();
-            }
-            else
-            {
-                operate_landing_gear();
-            }
-            m_waypoints.pop_front();
-        }
+CrashReason Aircraft::update_after_move()
+{
+    if (!m_store.is_moving(m_handle))
+    {
+        return CrashReason::none;
+    }
 
-        if (is_on_ground())
+    // if we are close to our next waypoint, stike if off the list
+    if (!m_waypoints.empty() && distance_to(m_waypoints.front()) < DISTANCE_THRESHOLD)
+    {
+        if (m_waypoints.front().is_at_terminal())
         {
-            if (!m_landing_gear_deployed)
-            {
-                using namespace std::string_literals;
-                throw AircraftCrash { m_flight_number, m_pos, m_speed, "bad landing" };
-            }
+            arrive_at_terminal();
         }
         else
         {
-            // if we are in the air, but too slow, then we will sink!
-            const float speed_len = m_speed.length();
-            if (speed_len < SPEED_THRESHOLD)
-            {
-                m_pos.z() -= SINK_FACTOR * (SPEED_THRESHOLD - speed_len);
-            }
+            operate_landing_gear();
         }
+        m_waypoints.pop_front();
+        sync_waypoints();
+    }
 
-        // update the z-value of the displayable structure
-        GL::Displayable::z = m_pos.x() + m_pos.y();
+    // (slow aircrafts have already sunk, see AircraftStore::move)
+    if (is_on_ground() && !test(AircraftStore::landing_gear_deployed))
+    {
+        return CrashReason::bad_landing;
     }
+
+    // update the z-value of the displayable structure
+    GL::Displayable::z = pos().x() + pos().y();
+    return CrashReason::none;
 }
 
 void Aircraft::display() const
 {
-    m_type.texture.draw(project_2D(m_pos), { PLANE_TEXTURE_DIM, PLANE_TEXTURE_DIM }, get_speed_octant());
+    m_type.texture.draw(project_2D(pos()), { PLANE_TEXTURE_DIM, PLANE_TEXTURE_DIM }, get_speed_octant());
 }
 
 bool Aircraft::has_terminal() const
@@ -175,34 +124,14 @@ bool Aircraft::has_terminal() const
     return false;
 }
 
-bool Aircraft::operator<(const Aircraft& other)
-{
-    if (has_terminal())
-    {
-        if(other.has_terminal())
-        {
-            return m_fuel < other.m_fuel;
-        }
-        return true;
-    }
-    else
-    {
-        if(other.has_terminal())
-        {
-            return false;
-        }
-        return m_fuel < other.m_fuel;
-    }
-}
-
 void Aircraft::refill(float &fuel_stock)
 {
-    float fuel_needed = GL::max_fuel - m_fuel;
+    float fuel_needed = GL::max_fuel - get_fuel();
     float fuel_refilled = fuel_stock > fuel_needed ? fuel_needed : fuel_stock;
     if(fuel_stock > 0)
     {
         fuel_stock -= fuel_refilled;
-        m_fuel += fuel_refilled;
-        std::cout << "Refilling " << fuel_refilled << " liters of fuel to aircraft " << m_flight_number << "." << std::endl;
+        m_store.refuel(m_handle, fuel_refilled);
+        events::logger.log(events::Kind::refill, m_flight_id, pos(), fuel_refilled);
     }
 }
\ No newline at end of file
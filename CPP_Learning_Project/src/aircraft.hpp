@@ -1,37 +1,37 @@
 #pragma once
 
-#include <string_view>
-
 #include "GL/displayable.hpp"
 
+#include "aircraft_store.hpp"
+#include "flight_numbers.hpp"
 #include "geometry.hpp"
 #include "tower.hpp"
 #include "waypoint.hpp"
 #include "aircraft_types.hpp"
 
-class Aircraft : public GL::Displayable, public GL::DynamicObject
+// aircrafts are not in GL::move_queue: their manager moves them all at once (see AircraftManager::move)
+class Aircraft : public GL::Displayable
 {
 private:
     const AircraftType& m_type;
-    const std::string m_flight_number;
-    Point3D m_pos, m_speed; // note: the speed should always be normalized to length 'speed'
+    const flights::Id m_flight_id;
     WaypointQueue m_waypoints = {};
     Tower& m_control;
 
-    bool m_landing_gear_deployed = false; // is the landing gear deployed?
-    bool m_is_at_terminal        = false;
-    bool m_has_landed            = false;
-    bool m_has_crashed           = false;
-    float m_fuel                 = 0.f;
+    // position, speed, fuel and state flags live in the store, so that the
+    // kinematics of all aircrafts can be streamed over contiguous arrays
+    // note: the speed should always be normalized to length 'speed'
+    AircraftStore& m_store;
+    const AircraftStore::Handle m_handle;
+
+    inline Point3D& pos() { return m_store.pos(m_handle); }
+    inline const Point3D& pos() const { return m_store.pos(m_handle); }
+    inline const Point3D& speed() const { return m_store.speed(m_handle); }
+    inline bool test(AircraftStore::Flag flag) const { return m_store.test(m_handle, flag); }
+    inline void set(AircraftStore::Flag flag, bool value) { m_store.set(m_handle, flag, value); }
 
-    // turn the aircraft to arrive at the next waypoint
-    // try to facilitate reaching the waypoint after the next by facing the
-    // right way to this end, we try to face the point Z on the line spanned by
-    // the next two waypoints such that Z's distance to the next waypoint is
-    // half our distance so: |w1 - pos| = d and [w1 - w2].normalize() = W and Z
-    // = w1 + W*d/2
-    void turn_to_waypoint(double delta_time);
-    void turn(Point3D direction);
+    // mirror the first two waypoints in the store, which turns the aircraft towards them
+    void sync_waypoints();
 
     // select the correct tile in the plane texture (series of 8 sprites facing
     // [North, NW, W, SW, S, SE, E, NE])
@@ -41,51 +41,60 @@ private:
     // deploy and retract landing gear depending on next waypoints
     void operate_landing_gear();
 
-    template <bool front>
-    void add_waypoint(const Waypoint& wp);
-    
-    inline bool is_on_ground() const { return m_pos.z() < DISTANCE_THRESHOLD; }
+    inline bool is_on_ground() const { return pos().z() < DISTANCE_THRESHOLD; }
     inline float max_speed() const { return is_on_ground() ? m_type.max_ground_speed : m_type.max_air_speed; }
 
     Aircraft(const Aircraft&) = delete;
     Aircraft& operator=(const Aircraft&) = delete;
 
 public:
-    Aircraft(const AircraftType& type_, const std::string_view& flight_number_, const Point3D& pos_,
-             const Point3D& speed_, Tower& control_, float fuel_) :
+    Aircraft(const AircraftType& type_, const flights::Id flight_id_, const Point3D& pos_,
+             const Point3D& speed_, Tower& control_, float fuel_, AircraftStore& store_) :
         GL::Displayable { pos_.x() + pos_.y() },
         m_type            { type_ },
-        m_flight_number   { flight_number_ },
-        m_pos             { pos_ },
-        m_speed           { speed_ },
+        m_flight_id       { flight_id_ },
         m_control         { control_ },
-        m_fuel            { fuel_ }
+        m_store           { store_ },
+        m_handle          { m_store.add(type_, pos_, speed_, fuel_) }
     {
-        m_speed.cap_length(max_speed());
+        m_store.speed(m_handle).cap_length(max_speed());
     }
 
     ~Aircraft()
-    {}
+    {
+        m_store.remove(m_handle);
+    }
 
-    inline const std::string& get_flight_num() const { return m_flight_number; }
-    inline float distance_to(const Point3D& p) const { return m_pos.distance_to(p); }
+    inline flights::Id get_flight_id() const { return m_flight_id; }
+    inline const AircraftType& get_type() const { return m_type; }
+    inline AircraftStore::Handle get_handle() const { return m_handle; }
+    inline float distance_to(const Point3D& p) const { return pos().distance_to(p); }
 
     void display() const override;
-    void move(double delta_time) override;
-
-    inline bool is_out_of_sim() const override { return (m_has_landed && !m_is_at_terminal && m_waypoints.empty()) || m_has_crashed; }
-    inline void crash() { m_has_crashed = true; }
-    inline bool has_crashed() const { return m_has_crashed; }
+    // a tick is split in two halves around the kinematics of the store (see AircraftManager::move):
+    // both return why the aircraft crashed, if it did (the caller then crashes it)
+    // 1. once the fuel is burnt, check it and get new waypoints from the tower
+    [[nodiscard]] CrashReason update_waypoints();
+    // 2. once moved (and sunk, if too slow), strike reached waypoints off the list and check the landing
+    [[nodiscard]] CrashReason update_after_move();
+
+    inline bool is_out_of_sim() const { return (has_landed() && !is_at_terminal() && m_waypoints.empty()) || has_crashed(); }
+    inline void crash()
+    {
+        set(AircraftStore::crashed, true);
+        m_control.aircraft_crashed(*this);
+    }
+    inline bool has_crashed() const { return test(AircraftStore::crashed); }
     
     bool has_terminal() const;
-    inline bool is_circling() const { return !m_has_landed && !has_terminal(); }
-    inline bool is_at_terminal() const { return m_is_at_terminal; }
-    inline bool has_left() const { return m_has_landed && !m_is_at_terminal; }
-
-    bool operator<(const Aircraft&);
-
-    inline bool is_low_on_fuel() const { return m_fuel < 400.f; }
-    inline float get_fuel() const { return m_fuel; }
+    inline bool has_landed() const { return test(AircraftStore::landed); }
+    inline bool is_circling() const { return !has_landed() && !has_terminal(); }
+    inline bool is_at_terminal() const { return test(AircraftStore::at_terminal); }
+    inline bool has_left() const { return has_landed() && !is_at_terminal(); }
+
+    inline bool is_low_on_fuel() const { return test(AircraftStore::low_on_fuel); }
+    inline float get_fuel() const { return m_store.fuel(m_handle); }
+    inline double get_unburnt_fuel() const { return m_store.unburnt_fuel(m_handle); }
     void refill(float& fuel_stock);
     
     friend class Tower;
@@ -1,24 +1,61 @@
 #include "aircraft_factory.hpp"
 
-[[nodiscard]] std::unique_ptr<Aircraft> AircraftFactory::create_aircraft(const AircraftType& type, Tower& tower)
+#include <fstream>
+#include <sstream>
+
+void AircraftFactory::init_aircraft_types()
 {
-    std::string flight_number;
-    do 
+    const auto path = MediaPath { "aircraft_types.txt" }.get_full_path();
+    std::ifstream file { path };
+    if (!file)
+    {
+        throw std::runtime_error { "Cannot open " + path.string() };
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields { line };
+        std::string sprite;
+        if (!(fields >> sprite) || sprite.front() == '#')
+        {
+            continue;
+        }
+
+        float max_ground_speed = 0.f, max_air_speed = 0.f, max_accel = 0.f;
+        size_t num_tiles = NUM_AIRCRAFT_TILES;
+        if (!(fields >> max_ground_speed >> max_air_speed >> max_accel))
+        {
+            throw std::runtime_error { "Invalid aircraft type in " + path.string() + ": " + line };
+        }
+        fields >> num_tiles;
+
+        m_aircraft_types.emplace_back(
+            new AircraftType { m_aircraft_types.size(), max_ground_speed, max_air_speed, max_accel, MediaPath { sprite },
+                               num_tiles });
+    }
+
+    if (m_aircraft_types.empty())
     {
-        flight_number = m_airlines[std::rand() % 8] + std::to_string(1000 + (rand() % 9000));
+        throw std::runtime_error { "No aircraft type in " + path.string() };
     }
-    while (m_used_names.find(flight_number) != m_used_names.end());
-    m_used_names.emplace(flight_number);
-    
-    const float angle       = (rand() % 1000) * 2 * 3.141592f / 1000.f; // random angle between 0 and 2pi
-    const Point3D start     = Point3D { std::sin(angle), std::cos(angle), 0.f } * 3 + Point3D { 0.f, 0.f, 2.f };
+}
+
+[[nodiscard]] AircraftPtr AircraftFactory::create_aircraft(const AircraftType& type, Tower& tower, AircraftManager& manager)
+{
+    const auto flight_id    = manager.get_flight_numbers().allocate();
+    // spread around the airport, not on one ring at one altitude where they would collide at once
+    const float angle       = m_spawn_angle(m_rengine);
+    const float radius      = m_spawn_radius(m_rengine);
+    const float altitude    = m_spawn_altitude(m_rengine);
+    const Point3D start     = Point3D { std::sin(angle), std::cos(angle), 0.f } * radius + Point3D { 0.f, 0.f, altitude };
     const Point3D direction = (-start).normalize();
     float fuel              = m_fuel_range(m_rengine);
 
-    return std::make_unique<Aircraft> (type, flight_number, start, direction, tower, fuel);
+    return manager.get_aircraft_pool().make(type, flight_id, start, direction, tower, fuel, manager.get_store());
 }
 
-[[nodiscard]] std::unique_ptr<Aircraft> AircraftFactory::create_random_aircraft(Tower& tower)
+[[nodiscard]] AircraftPtr AircraftFactory::create_random_aircraft(Tower& tower, AircraftManager& manager)
 {
-    return create_aircraft(*(m_aircraft_types[rand() % 3]), tower);
+    return create_aircraft(*(m_aircraft_types[rand() % m_aircraft_types.size()]), tower, manager);
 }
\ No newline at end of file
@@ -4,37 +4,34 @@
 #include <string_view>
 
 #include "aircraft.hpp"
+#include "aircraft_manager.hpp"
 
 class AircraftFactory
 {
-private:
-    static const size_t NUM_AIRCRAFT_TYPES = 3;
-    static const size_t NUM_AIRLINES = 8;
-
 public:
     AircraftFactory ()
         : m_rengine      { std::random_device{}() }
         , m_fuel_range   { 150.f, GL::max_fuel }
     {}
 
-    inline void init_aircraft_types()
-    {
-        m_aircraft_types[0] = new AircraftType { .7f, .7f, .5f, MediaPath { "l1011_48px.png" } };
-        m_aircraft_types[1] = new AircraftType { .7f, .7f, .5f, MediaPath { "b707_jat.png" } };
-        m_aircraft_types[2] = new AircraftType { .9f, .9f, .5f, MediaPath { "concorde_af.png" } };
-    }
+    // reads the aircraft types from media/aircraft_types.txt, their sprites go to the texture atlas
+    void init_aircraft_types();
 
-    [[nodiscard]] std::unique_ptr<Aircraft> create_random_aircraft(Tower& tower);
-    [[nodiscard]] inline const std::array<std::string, NUM_AIRLINES> get_airlines() const { return m_airlines; }
+    inline void seed(const unsigned int seed_) { m_rengine.seed(seed_); }
+    // fuel of the aircrafts created from now on, drawn in [min, max)
+    inline void set_fuel_range(const float min, const float max) { m_fuel_range = decltype(m_fuel_range) { min, max }; }
+
+    // the aircraft is to be added to the given manager
+    [[nodiscard]] AircraftPtr create_random_aircraft(Tower& tower, AircraftManager& manager);
 
 private:
-    AircraftType* m_aircraft_types[NUM_AIRCRAFT_TYPES] {};
-    const std::array<std::string, NUM_AIRLINES> m_airlines = { "AF", "LH", "EY", "DL", "KL", "BA", "AY", "EY" };
+    std::vector<AircraftType*> m_aircraft_types;
 
     std::mt19937 m_rengine;
     std::uniform_real_distribution<float> m_fuel_range;
+    std::uniform_real_distribution<float> m_spawn_angle { 0.f, 2.f * 3.141592f };
+    std::uniform_real_distribution<float> m_spawn_radius { 3.f, 6.f };
+    std::uniform_real_distribution<float> m_spawn_altitude { 1.f, 3.f };
 
-    std::set<std::string> m_used_names; 
-
-    [[nodiscard]] std::unique_ptr<Aircraft> create_aircraft(const AircraftType& type, Tower& tower);
+    [[nodiscard]] AircraftPtr create_aircraft(const AircraftType& type, Tower& tower, AircraftManager& manager);
 };
\ No newline at end of file
@@ -1,34 +1,203 @@
 #include "aircraft_manager.hpp"
 #include "aircraft.hpp"
+#include "event_log.hpp"
+#include "profiler.hpp"
 
-void AircraftManager::add_aircraft(std::unique_ptr<Aircraft> aircraft)
+#include <algorithm>
+#include <stdexcept>
+
+void AircraftManager::add_aircraft(AircraftPtr aircraft)
 {
+    const auto handle = aircraft->get_handle();
+    if (handle >= m_by_handle.size())
+    {
+        m_by_handle.resize(handle + 1, nullptr);
+    }
+    m_by_handle[handle] = aircraft.get();
+    m_display_order.emplace_back(aircraft.get());
+
+    const auto type = aircraft->get_type().index;
+    if (type >= m_type_counts.size())
+    {
+        m_type_counts.resize(type + 1, 0);
+    }
+    ++m_type_counts[type];
+    ++m_airline_counts[flights::airline(aircraft->get_flight_id())];
+
     m_aircrafts.emplace_back(std::move(aircraft));
 }
 
+void AircraftManager::crash(Aircraft& aircraft, const CrashReason reason, const Aircraft* other)
+{
+    aircraft.crash();
+    ++m_crashed_aircrafts;
+    m_crashes.push_back({ aircraft.get_handle(), reason, other ? other->get_handle() : aircraft.get_handle() });
+}
+
+void AircraftManager::log_crashes() const
+{
+    for (const auto& [handle, reason, other] : m_crashes)
+    {
+        const Aircraft& aircraft = *m_by_handle[handle];
+        events::logger.log_crash(aircraft.get_flight_id(), m_store.pos(handle), m_store.speed(handle), reason,
+                                 other != handle ? m_by_handle[other]->get_flight_id() : flights::NONE);
+    }
+}
+
+void AircraftManager::check_proximity()
+{
+    m_grid.rebuild(m_store);
+
+    m_collisions.clear();
+    m_next_near_miss_pairs.clear();
+    m_grid.for_each_pair_within(NEAR_MISS_DISTANCE, [this](const AircraftStore::Handle first,
+                                                           const AircraftStore::Handle second) {
+        // parked and crashed aircrafts are out of the way
+        if (!m_store.is_moving(first) || !m_store.is_moving(second))
+        {
+            return;
+        }
+
+        if (m_collisions_enabled && m_store.pos(first).distance_to(m_store.pos(second)) < DISTANCE_THRESHOLD)
+        {
+            m_collisions.emplace_back(first, second);
+        }
+        else
+        {
+            // only count and log the near misses that just started
+            const std::pair<AircraftStore::Handle, AircraftStore::Handle> pair = std::minmax(first, second);
+            if (!std::binary_search(m_near_miss_pairs.begin(), m_near_miss_pairs.end(), pair))
+            {
+                ++m_near_misses;
+                events::logger.log_near_miss(m_by_handle[first]->get_flight_id(), m_store.pos(first),
+                                             m_by_handle[second]->get_flight_id());
+            }
+            m_next_near_miss_pairs.emplace_back(pair);
+        }
+    });
+    std::sort(m_next_near_miss_pairs.begin(), m_next_near_miss_pairs.end());
+
+    for (const auto& [first, second] : m_near_miss_pairs)
+    {
+        m_store.set(first, AircraftStore::near_miss, false);
+        m_store.set(second, AircraftStore::near_miss, false);
+    }
+    for (const auto& [first, second] : m_next_near_miss_pairs)
+    {
+        m_store.set(first, AircraftStore::near_miss, true);
+        m_store.set(second, AircraftStore::near_miss, true);
+    }
+    // both buffers keep their capacity from one tick to the next
+    m_near_miss_pairs.swap(m_next_near_miss_pairs);
+
+    for (const auto& [first, second] : m_collisions)
+    {
+        Aircraft& a1 = *m_by_handle[first];
+        Aircraft& a2 = *m_by_handle[second];
+        for (auto [aircraft, other] : { std::pair { &a1, &a2 }, std::pair { &a2, &a1 } })
+        {
+            if (!aircraft->has_crashed())
+            {
+                crash(*aircraft, CrashReason::collision, other);
+            }
+        }
+    }
+}
+
 void AircraftManager::move(double delta_time)
 {
-    std::sort(m_aircrafts.begin(), m_aircrafts.end(),
-        [](const std::unique_ptr<Aircraft>& a1,const std::unique_ptr<Aircraft>& a2) { return a1 < a2; });
-        
-    for(auto it = m_aircrafts.begin(); it != m_aircrafts.end();)
+    events::logger.new_tick();
+    m_crashes.clear();
+
+    // aircrafts are updated in the order they were added: the tower decides who
+    // lands first (see Tower::reserve_terminal)
+    const auto update_all = [this](CrashReason (Aircraft::*update)())
     {
-        auto& aircraft = *it;
-        try
+        for (auto& aircraft : m_aircrafts)
         {
-            aircraft->move(delta_time);
+            if (const auto reason = ((*aircraft).*update)(); reason != CrashReason::none)
+            {
+                crash(*aircraft, reason);
+            }
         }
-        catch (const AircraftCrash& crash)
+    };
+
+    // only the aircraft updates talk to the tower, fuel and kinematics stream over the
+    // store in parallel: each aircraft being updated on its own, the result does not
+    // depend on the number of threads
+    // (the profiler sees two kinematics calls per tick; the tower is timed over the whole
+    // pass, a timer per aircraft would cost as much as what it measures)
+    {
+        PROFILE_SCOPE(aircraft_kinematics);
+        m_store.burn_fuel(delta_time, *m_pool);
+    }
+    {
+        PROFILE_SCOPE(tower);
+        update_all(&Aircraft::update_waypoints);
+    }
+    {
+        PROFILE_SCOPE(aircraft_kinematics);
+        m_store.move(delta_time, *m_pool);
+    }
+    {
+        PROFILE_SCOPE(aircraft_update);
+        update_all(&Aircraft::update_after_move);
+    }
+    {
+        PROFILE_SCOPE(proximity);
+        check_proximity();
+    }
+    log_crashes();
+
+    PROFILE_SCOPE(aircraft_erase);
+    // drop the leaving aircrafts from the display order, keeping it sorted
+    size_t kept = 0, kept_ordered = 0;
+    for (size_t index = 0; index < m_display_order.size(); ++index)
+    {
+        if (!m_display_order[index]->is_out_of_sim())
         {
-            aircraft->crash();
-            ++m_crashed_aircrafts;
-            std::cerr << crash.what() << std::endl;
+            kept_ordered += index < m_num_ordered;
+            m_display_order[kept++] = m_display_order[index];
         }
-        ++it;
     }
+    m_display_order.resize(kept);
+    m_num_ordered = kept_ordered;
+
+    const auto num_aircrafts = m_aircrafts.size();
+    m_aircrafts.erase(std::remove_if(m_aircrafts.begin(), m_aircrafts.end(), [this](AircraftPtr& a) {
+        if (!a->is_out_of_sim())
+        {
+            return false;
+        }
+        m_grid.remove(a->get_handle());
+        --m_type_counts[a->get_type().index];
+        --m_airline_counts[flights::airline(a->get_flight_id())];
+        m_flight_numbers.release(a->get_flight_id());
+        m_by_handle[a->get_handle()] = nullptr;
+        return true;
+    }), m_aircrafts.end());
 
-    m_aircrafts.erase(std::remove_if(m_aircrafts.begin(), m_aircrafts.end(), [](std::unique_ptr<Aircraft>& a) { return a->is_out_of_sim(); }),
-        m_aircrafts.end());
+    // the handles of the erased aircrafts go back to the store, and may be handed
+    // out again before the next check_proximity() clears the flags of this tick:
+    // forget their pairs now, clearing the flag of the aircraft left behind
+    if (m_aircrafts.size() != num_aircrafts)
+    {
+        std::erase_if(m_near_miss_pairs, [this](const auto& pair) {
+            const auto [first, second] = pair;
+            if (m_by_handle[first] && m_by_handle[second])
+            {
+                return false;
+            }
+            for (const auto handle : { first, second })
+            {
+                if (m_by_handle[handle])
+                {
+                    m_store.set(handle, AircraftStore::near_miss, false);
+                }
+            }
+            return true;
+        });
+    }
 }
 
 bool AircraftManager::is_out_of_sim() const
@@ -38,27 +207,43 @@ bool AircraftManager::is_out_of_sim() const
 
 void AircraftManager::display() const
 {
-    for(auto it = m_aircrafts.begin(); it != m_aircrafts.end(); ++it)
+    // aircrafts barely move between two frames: the order of the last frame is almost right
+    GL::restore_order(m_display_order, m_num_ordered, GL::disp_z_cmp {});
+    m_num_ordered = m_display_order.size();
+
+    for (const auto* aircraft : m_display_order)
     {
-        auto& aircraft = *it;
         aircraft->display();
     }
 }
 
-int AircraftManager::count_aircrafts_from_airline(const std::string& airline) const
+std::vector<const Aircraft*> AircraftManager::get_aircrafts_near(const Aircraft& aircraft, const float radius) const
 {
-    return std::count_if(m_aircrafts.begin(), m_aircrafts.end(), [airline](const std::unique_ptr<Aircraft>& aircraft) {
-        return aircraft->get_flight_num().compare(0, airline.size(), airline) == 0; 
+    std::vector<const Aircraft*> result;
+    const auto handle = aircraft.get_handle();
+    m_grid.for_each_within(m_store.pos(handle), radius, [this, handle, &result](const AircraftStore::Handle other) {
+        if (other != handle)
+        {
+            result.emplace_back(m_by_handle[other]);
+        }
     });
+    return result;
 }
 
-[[nodiscard]] float AircraftManager::get_required_fuel() const
+void AircraftManager::snapshot(TrafficStats& stats) const
 {
-    float total_fuel = 0.f;
-    auto filtered_aircrafts = m_aircrafts | std::views::filter([](const std::unique_ptr<Aircraft>& a) { return !a->has_left() && a->is_low_on_fuel(); });
-    
-    return std::accumulate(filtered_aircrafts.begin(), filtered_aircrafts.end(), 0.f,
-        [](float sum, const std::unique_ptr<Aircraft>& aircraft) { return sum + (3000.f - aircraft->get_fuel()); });
+    stats.aircrafts   = m_aircrafts.size();
+    stats.per_airline = m_airline_counts;
+    stats.per_type.assign(m_type_counts.begin(), m_type_counts.end());
+    for (size_t state = 0; state < AircraftStore::NUM_STATES; ++state)
+    {
+        stats.per_state[state] = m_store.count(static_cast<AircraftStore::State>(state));
+    }
+    stats.crashed     = m_crashed_aircrafts;
+    stats.near_misses = m_near_misses;
+}
 
-    return total_fuel;
+[[nodiscard]] float AircraftManager::get_required_fuel() const
+{
+    return static_cast<float>(m_store.fuel_demand(GL::max_fuel));
 }
\ No newline at end of file
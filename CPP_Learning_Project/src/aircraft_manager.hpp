@@ -4,32 +4,129 @@
 
 #include "GL/dynamic_object.hpp"
 #include "GL/displayable.hpp"
+#include "aircraft_store.hpp"
+#include "config.hpp"
+#include "flight_numbers.hpp"
+#include "object_pool.hpp"
+#include "spatial_grid.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
 
 class Aircraft;
 
+// aircrafts are recycled in the pool of their manager instead of going back to the heap
+using AircraftPool = ObjectPool<Aircraft>;
+using AircraftPtr  = AircraftPool::Ptr;
+
+// a crash recorded during a tick: crashed aircrafts stop moving, so their position
+// and speed are still those of the crash when it is logged at the end of the tick
+struct AircraftCrash
+{
+    AircraftStore::Handle handle;
+    CrashReason reason;
+    AircraftStore::Handle other; // the aircraft collided with, 'handle' otherwise
+};
+
+// counters of the traffic at a given tick, filled by AircraftManager::snapshot
+struct TrafficStats
+{
+    size_t aircrafts = 0;
+    std::array<int, flights::AIRLINES.size()> per_airline {};
+    std::vector<int> per_type; // indexed by AircraftType::index
+    std::array<size_t, AircraftStore::NUM_STATES> per_state {};
+    int crashed     = 0; // since the start, unlike per_state
+    int near_misses = 0;
+};
+
 class AircraftManager : public GL::DynamicObject, public GL::Displayable
 {
 public:
     AircraftManager() 
         : GL::Displayable { 0 }
     {
-        GL::move_queue.emplace(this);
+        GL::move_queue.emplace_back(this);
         GL::display_queue.emplace_back(this);
+        m_crashes.reserve(64);
+    }
+    ~AircraftManager()
+    {
+        GL::display_queue.erase(std::remove(GL::display_queue.begin(), GL::display_queue.end(), this));
+        GL::move_queue.erase(std::remove(GL::move_queue.begin(), GL::move_queue.end(), this));
     }
-    ~AircraftManager() {}
 
-    void add_aircraft(std::unique_ptr<Aircraft> aircraft);
+    void add_aircraft(AircraftPtr aircraft);
+    // aircrafts must be created in the store and the pool of the manager they are added to
+    AircraftStore& get_store() { return m_store; }
+    AircraftPool& get_aircraft_pool() { return m_aircraft_pool; }
+    // the flight numbers of the aircrafts that left are released
+    flights::Allocator& get_flight_numbers() { return m_flight_numbers; }
+    // threads used by the kinematics (the tower is only ever contacted from the calling thread)
+    void set_num_threads(const unsigned int num_threads) { m_pool = std::make_unique<ThreadPool>(num_threads); }
+    // when disabled (the default), aircrafts closer than DISTANCE_THRESHOLD fly through
+    // each other: the tower does not separate the approaches from the departures
+    void set_collisions(const bool enabled) { m_collisions_enabled = enabled; }
     void display() const override;
 
     void move(double) override;
     bool is_out_of_sim() const override;
 
-    int count_aircrafts_from_airline(const std::string& airline) const;
+    // airline is an index in flights::AIRLINES
+    int count_aircrafts_from_airline(const size_t airline) const { return m_airline_counts[airline]; }
+    int count_aircrafts_of_type(const size_t type) const { return type < m_type_counts.size() ? m_type_counts[type] : 0; }
+    size_t count_aircrafts_in_state(const AircraftStore::State state) const { return m_store.count(state); }
     int count_crashed_aircrafts() const { return m_crashed_aircrafts; }
+    int count_near_misses() const { return m_near_misses; }
+    size_t count_live_aircrafts() const { return m_aircraft_pool.live(); }
+    size_t count_peak_aircrafts() const { return m_aircraft_pool.peak(); }
+    // all the counters at once, reusing the buffers of stats
+    void snapshot(TrafficStats& stats) const;
+    // crashes of the last tick
+    const std::vector<AircraftCrash>& get_last_crashes() const { return m_crashes; }
+
+    // aircrafts within radius of the given one (as of the end of the last tick)
+    std::vector<const Aircraft*> get_aircrafts_near(const Aircraft& aircraft, const float radius) const;
 
+    // fuel needed to fill up the aircrafts low on fuel that have not left yet, in O(1)
     float get_required_fuel() const;
 
 private:
-    std::vector<std::unique_ptr<Aircraft>> m_aircrafts;
+    // declared first: aircrafts release their slot of the store and of the pool when destroyed
+    AircraftStore m_store;
+    AircraftPool m_aircraft_pool;
+    flights::Allocator m_flight_numbers;
+    std::vector<AircraftPtr> m_aircrafts;
+    std::unique_ptr<ThreadPool> m_pool = std::make_unique<ThreadPool>(std::thread::hardware_concurrency());
+    // kept up to date on spawn and despawn instead of scanning the aircrafts
+    std::array<int, flights::AIRLINES.size()> m_airline_counts {};
+    std::vector<int> m_type_counts;
     int m_crashed_aircrafts = 0;
+    int m_near_misses       = 0;
+    bool m_collisions_enabled = false;
+
+    // rebuilt every tick, with cells at least as large as the near-miss distance:
+    // a check only looks at the neighbouring cells
+    SpatialGrid m_grid { NEAR_MISS_DISTANCE };
+    std::vector<Aircraft*> m_by_handle;
+    std::vector<std::pair<AircraftStore::Handle, AircraftStore::Handle>> m_collisions;
+    // the pairs of aircrafts in a near miss at the last tick, as (smaller, larger) handles
+    // in increasing order: a pair is counted and logged on the tick it shows up
+    std::vector<std::pair<AircraftStore::Handle, AircraftStore::Handle>> m_near_miss_pairs;
+    // filled by check_proximity, then swapped with m_near_miss_pairs
+    std::vector<std::pair<AircraftStore::Handle, AircraftStore::Handle>> m_next_near_miss_pairs;
+    // aircrafts by decreasing z, as of the last frame: only the first m_num_ordered
+    // ones were there at that time, the others have been added since
+    mutable std::vector<const Aircraft*> m_display_order;
+    mutable size_t m_num_ordered = 0;
+    // cleared every tick, keeps its capacity
+    std::vector<AircraftCrash> m_crashes;
+
+    void crash(Aircraft& aircraft, const CrashReason reason, const Aircraft* other = nullptr);
+    // hand the crashes of this tick over to the event log
+    void log_crashes() const;
+    // rebuild the grid, then crash colliding aircrafts and count near misses
+    void check_proximity();
 };
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "aircraft_store.hpp"
+
+#include "aircraft_types.hpp"
+
+AircraftStore::Handle AircraftStore::add(const AircraftType& type, const Point3D& pos, const Point3D& speed,
+                                         float fuel)
+{
+    Handle handle;
+    if (m_free_handles.empty())
+    {
+        handle = static_cast<Handle>(m_indices.size());
+        m_indices.emplace_back();
+    }
+    else
+    {
+        handle = m_free_handles.back();
+        m_free_handles.pop_back();
+    }
+
+    m_indices[handle] = static_cast<uint32_t>(m_handles.size());
+    m_handles.emplace_back(handle);
+    m_pos.emplace_back(pos);
+    m_speed.emplace_back(speed);
+    m_waypoint.emplace_back(0.f, 0.f, 0.f);
+    m_next_waypoint.emplace_back(0.f, 0.f, 0.f);
+    m_fuel.emplace_back(fuel);
+    const uint8_t flags = fuel < LOW_FUEL ? low_on_fuel : 0;
+    m_flags.emplace_back(flags);
+    ++m_state_counts[static_cast<size_t>(state_of(flags))];
+    if (needs_fuel(flags))
+    {
+        count_fuel_demand(m_handles.size() - 1, 1);
+    }
+    m_limits.push_back({ type.max_ground_speed, type.max_air_speed, type.max_accel });
+
+    return handle;
+}
+
+void AircraftStore::remove(const Handle handle)
+{
+    const auto index = index_of(handle);
+    const auto last  = m_handles.size() - 1;
+    --m_state_counts[static_cast<size_t>(state_of(m_flags[index]))];
+    if (needs_fuel(m_flags[index]))
+    {
+        count_fuel_demand(index, -1);
+    }
+
+    if (index != last)
+    {
+        m_pos[index]           = m_pos[last];
+        m_speed[index]         = m_speed[last];
+        m_waypoint[index]      = m_waypoint[last];
+        m_next_waypoint[index] = m_next_waypoint[last];
+        m_fuel[index]          = m_fuel[last];
+        m_flags[index]         = m_flags[last];
+        m_limits[index]        = m_limits[last];
+        m_handles[index]       = m_handles[last];
+        m_indices[m_handles[index]] = index;
+    }
+
+    m_pos.pop_back();
+    m_speed.pop_back();
+    m_waypoint.pop_back();
+    m_next_waypoint.pop_back();
+    m_fuel.pop_back();
+    m_flags.pop_back();
+    m_limits.pop_back();
+    m_handles.pop_back();
+    m_indices[handle] = NO_INDEX;
+    m_free_handles.emplace_back(handle);
+}
+
+void AircraftStore::set_waypoints(const Handle handle, const Point3D* first, const Point3D* second)
+{
+    const auto index = index_of(handle);
+    // the waypoint flags do not change the state: no need to go through set()
+    auto& flags = m_flags[index];
+    flags = (flags & ~(has_waypoint | has_next_waypoint)) | (first ? has_waypoint : 0) | (second ? has_next_waypoint : 0);
+    if (first)
+    {
+        m_waypoint[index] = *first;
+    }
+    if (second)
+    {
+        m_next_waypoint[index] = *second;
+    }
+}
+
+void AircraftStore::refuel(const Handle handle, const float amount)
+{
+    const auto index = index_of(handle);
+    if (needs_fuel(m_flags[index]))
+    {
+        count_fuel_demand(index, -1);
+    }
+
+    m_fuel[index] += amount;
+    m_flags[index] = m_fuel[index] < LOW_FUEL ? (m_flags[index] | low_on_fuel) : (m_flags[index] & ~low_on_fuel);
+    if (needs_fuel(m_flags[index]))
+    {
+        count_fuel_demand(index, 1);
+    }
+}
+
+void AircraftStore::burn_fuel(const double delta_time, ThreadPool& pool)
+{
+    const float consumption = FUEL_CONSUMPTION * default_ticks_in(delta_time);
+    m_fuel_burnt += consumption;
+    // a chunk covers [n * PARALLEL_GRAIN, (n + 1) * PARALLEL_GRAIN), or everything if run inline
+    m_chunk_demand.assign((size() + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN, FuelDemand {});
+    pool.parallel_for(size(), PARALLEL_GRAIN, [this, consumption](const size_t begin, const size_t end) {
+        auto& crossed = m_chunk_demand[begin / PARALLEL_GRAIN];
+        for (size_t index = begin; index < end; ++index)
+        {
+            m_fuel[index] -= consumption;
+            if (!(m_flags[index] & low_on_fuel) && m_fuel[index] < LOW_FUEL)
+            {
+                m_flags[index] |= low_on_fuel;
+                if (needs_fuel(m_flags[index]))
+                {
+                    ++crossed.count;
+                    crossed.unburnt += m_fuel[index] + m_fuel_burnt;
+                }
+            }
+        }
+    });
+
+    for (const auto& crossed : m_chunk_demand)
+    {
+        m_fuel_demand.count += crossed.count;
+        m_fuel_demand.unburnt += crossed.unburnt;
+    }
+}
+
+void AircraftStore::move(const double delta_time, ThreadPool& pool)
+{
+    pool.parallel_for(size(), PARALLEL_GRAIN, [this, delta_time](const size_t begin, const size_t end) {
+        move_range(begin, end, delta_time);
+    });
+}
+
+// every aircraft goes through the same straight-line code, the flags only select which
+// results are kept: aircrafts without waypoints keep their speed, the others keep
+// their state (their stale waypoints are harmless to compute with)
+void AircraftStore::move_range(const size_t begin, const size_t end, const double delta_time)
+{
+    Point3D* const pos                  = m_pos.data();
+    Point3D* const speed                = m_speed.data();
+    const Point3D* const waypoint       = m_waypoint.data();
+    const Point3D* const next_waypoint  = m_next_waypoint.data();
+    const SpeedLimits* const limits     = m_limits.data();
+    const uint8_t* const flags          = m_flags.data();
+    const float inv_delta_time          = static_cast<float>(1.f / delta_time);
+    // the acceleration and the sinking are given per tick
+    const float ticks                   = default_ticks_in(delta_time);
+
+    for (size_t index = begin; index < end; ++index)
+    {
+        Point3D p = pos[index];
+        Point3D v = speed[index];
+
+        // turn the aircraft to arrive at the next waypoint, facing the point Z on the line
+        // spanned by the next two waypoints such that |Z - w1| = |w1 - pos| / 2
+        const Point3D& w1     = waypoint[index];
+        const Point3D ahead   = w1 - next_waypoint[index];
+        const float ahead_len = ahead.length();
+        const bool look_ahead = (flags[index] & has_next_waypoint) && ahead_len > 0.f;
+        const float d         = (w1 - p).length();
+        const Point3D target  = w1 + ahead * (look_ahead ? (d / 2.0f) / ahead_len : 0.f);
+
+        const float max_speed   = p.z() < DISTANCE_THRESHOLD ? limits[index].max_ground_speed : limits[index].max_air_speed;
+        const Point3D direction = (target - p) * inv_delta_time;
+        Point3D steered         = v;
+        (steered += (direction - v).cap_length(limits[index].max_accel * ticks)).cap_length(max_speed);
+        v = (flags[index] & has_waypoint) ? steered : v;
+
+        // move in the direction of the current speed
+        p += v * delta_time;
+
+        // if we are in the air, but too slow, then we will sink!
+        const float speed_len = v.length();
+        const bool sinking    = p.z() >= DISTANCE_THRESHOLD && speed_len < SPEED_THRESHOLD;
+        p.z() -= sinking ? SINK_FACTOR * (SPEED_THRESHOLD - speed_len) * ticks : 0.f;
+
+        const bool moving = is_moving_at(index);
+        pos[index]        = moving ? p : pos[index];
+        speed[index]      = moving ? v : speed[index];
+    }
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "geometry.hpp"
+#include "thread_pool.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+struct AircraftType;
+
+// speed limits of the aircraft type, copied next to the state of every aircraft
+struct SpeedLimits
+{
+    float max_ground_speed;
+    float max_air_speed;
+    float max_accel;
+};
+
+// structure-of-arrays storage of the aircraft state touched on every tick
+// aircrafts refer to their slot through a stable handle while the arrays stay
+// dense: removing an aircraft moves the last one into its place
+
+class AircraftStore
+{
+public:
+    using Handle = uint32_t;
+
+    enum Flag : uint8_t
+    {
+        landing_gear_deployed = 1 << 0,
+        at_terminal           = 1 << 1,
+        landed                = 1 << 2,
+        crashed               = 1 << 3,
+        // the first two waypoints of the aircraft are mirrored in the store
+        has_waypoint      = 1 << 4,
+        has_next_waypoint = 1 << 5,
+        // was in a near miss on the last tick
+        near_miss = 1 << 6,
+        // has less than LOW_FUEL, kept up to date by add(), burn_fuel() and refuel()
+        low_on_fuel = 1 << 7,
+    };
+
+    // where an aircraft is in its journey, deduced from its flags
+    enum class State : uint8_t
+    {
+        incoming,    // flying to the airport, landing or taxiing to its terminal
+        at_terminal, // being serviced
+        leaving,     // serviced, on its way out
+        crashed,
+    };
+    static constexpr size_t NUM_STATES = 4;
+
+    [[nodiscard]] Handle add(const AircraftType& type, const Point3D& pos, const Point3D& speed, float fuel);
+    void remove(const Handle handle);
+
+    size_t size() const { return m_handles.size(); }
+    // handle of the aircraft stored at index (in [0, size())), to walk the store
+    Handle handle_at(const size_t index) const { return m_handles[index]; }
+
+    Point3D& pos(const Handle handle) { return m_pos[index_of(handle)]; }
+    const Point3D& pos(const Handle handle) const { return m_pos[index_of(handle)]; }
+    Point3D& speed(const Handle handle) { return m_speed[index_of(handle)]; }
+    const Point3D& speed(const Handle handle) const { return m_speed[index_of(handle)]; }
+    float fuel(const Handle handle) const { return m_fuel[index_of(handle)]; }
+    void refuel(const Handle handle, const float amount);
+    // fuel the aircraft would have if burn_fuel() had never been called: as it burns
+    // the same amount for everyone, this orders aircrafts by fuel and stays constant
+    // until the aircraft is refilled
+    double unburnt_fuel(const Handle handle) const { return fuel(handle) + m_fuel_burnt; }
+
+    bool test(const Handle handle, const Flag flag) const { return m_flags[index_of(handle)] & flag; }
+    void set(const Handle handle, const Flag flag, const bool value)
+    {
+        const auto index      = index_of(handle);
+        auto& flags           = m_flags[index];
+        const auto old_state  = state_of(flags);
+        const bool was_needed = needs_fuel(flags);
+        flags                 = value ? (flags | flag) : (flags & ~flag);
+        --m_state_counts[static_cast<size_t>(old_state)];
+        ++m_state_counts[static_cast<size_t>(state_of(flags))];
+        if (was_needed != needs_fuel(flags))
+        {
+            count_fuel_demand(index, was_needed ? -1 : 1);
+        }
+    }
+
+    State state(const Handle handle) const { return state_of(m_flags[index_of(handle)]); }
+    // number of aircrafts in the given state, kept up to date by add(), remove() and set()
+    size_t count(const State state) const { return m_state_counts[static_cast<size_t>(state)]; }
+
+    // null pointers mean "no such waypoint"
+    void set_waypoints(const Handle handle, const Point3D* first, const Point3D* second);
+
+    // is the aircraft moved by move()? (neither crashed, nor at its terminal, nor done)
+    bool is_moving(const Handle handle) const { return is_moving_at(index_of(handle)); }
+
+    // fuel needed to fill up the aircrafts low on fuel that have not left yet: the
+    // aggregate only changes when an aircraft crosses LOW_FUEL, refuels, changes state
+    // or is removed, as everyone burns the same amount between two of these events
+    double fuel_demand(const float max_fuel) const
+    {
+        return m_fuel_demand.count * (max_fuel + m_fuel_burnt) - m_fuel_demand.unburnt;
+    }
+
+    // every aircraft only touches its own slot, so both passes are spread over the pool
+    void burn_fuel(const double delta_time, ThreadPool& pool);
+    // turn every moving aircraft towards its waypoints, move it along its speed, then
+    // let it sink if it flies too slowly (see move_range)
+    void move(const double delta_time, ThreadPool& pool);
+
+private:
+    static constexpr uint32_t NO_INDEX = ~uint32_t { 0 };
+
+    // number of aircrafts handled by a task of the pool
+    static constexpr size_t PARALLEL_GRAIN = 1024;
+
+    std::vector<Point3D> m_pos;
+    std::vector<Point3D> m_speed;
+    std::vector<Point3D> m_waypoint;
+    std::vector<Point3D> m_next_waypoint;
+    std::vector<float> m_fuel;
+    std::vector<uint8_t> m_flags;
+    std::vector<SpeedLimits> m_limits;
+
+    std::vector<Handle> m_handles;   // dense index -> handle
+    std::vector<uint32_t> m_indices; // handle -> dense index, NO_INDEX once removed
+    std::vector<Handle> m_free_handles;
+
+    double m_fuel_burnt = 0.;
+    std::array<size_t, NUM_STATES> m_state_counts {};
+
+    // aircrafts counted in fuel_demand(), and the sum of their unburnt fuel
+    struct FuelDemand
+    {
+        size_t count   = 0;
+        double unburnt = 0.;
+    };
+    FuelDemand m_fuel_demand;
+    // aircrafts crossing LOW_FUEL in each chunk of burn_fuel(), summed up afterwards
+    std::vector<FuelDemand> m_chunk_demand;
+
+    // low on fuel, and neither crashed nor gone
+    static bool needs_fuel(const uint8_t flags)
+    {
+        return (flags & low_on_fuel) && !(flags & crashed) && !((flags & landed) && !(flags & at_terminal));
+    }
+
+    void count_fuel_demand(const size_t index, const int sign)
+    {
+        m_fuel_demand.count += sign;
+        // no rounding residue left once nobody needs fuel
+        m_fuel_demand.unburnt =
+            m_fuel_demand.count == 0 ? 0. : m_fuel_demand.unburnt + sign * (m_fuel[index] + m_fuel_burnt);
+    }
+
+    static State state_of(const uint8_t flags)
+    {
+        return (flags & crashed)       ? State::crashed
+               : (flags & at_terminal) ? State::at_terminal
+               : (flags & landed)      ? State::leaving
+                                       : State::incoming;
+    }
+
+    bool is_moving_at(const size_t index) const
+    {
+        const auto flags = m_flags[index];
+        return !(flags & (crashed | at_terminal)) && !((flags & landed) && !(flags & has_waypoint));
+    }
+
+    // a removed handle must not be used until add() hands it out again
+    uint32_t index_of(const Handle handle) const
+    {
+        assert(handle < m_indices.size() && m_indices[handle] != NO_INDEX);
+        return m_indices[handle];
+    }
+
+    // the kinematics kernel, one pass over [begin, end) of the arrays
+    void move_range(const size_t begin, const size_t end, const double delta_time);
+};
@@ -1,21 +1,23 @@
 #pragma once
 
 #include "GL/texture.hpp"
-#include "img/image.hpp"
+#include "config.hpp"
 #include "img/media_path.hpp"
 
 struct AircraftType
 {
+    const size_t index; // in the list of types (see AircraftFactory::init_aircraft_types)
     const float max_ground_speed;
     const float max_air_speed;
     const float max_accel;
     const GL::Texture2D texture;
 
-    AircraftType(const float max_ground_speed_, const float max_air_speed_, const float max_accel_,
-                 const MediaPath& sprite, const size_t num_tiles = NUM_AIRCRAFT_TILES) :
+    AircraftType(const size_t index_, const float max_ground_speed_, const float max_air_speed_,
+                 const float max_accel_, const MediaPath& sprite, const size_t num_tiles = NUM_AIRCRAFT_TILES) :
+        index { index_ },
         max_ground_speed { max_ground_speed_ },
         max_air_speed { max_air_speed_ },
         max_accel { max_accel_ },
-        texture { new img::Image { sprite.get_full_path() }, num_tiles }
+        texture { &sprite, num_tiles }
     {}
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "terminal.hpp"
 #include "airport_type.hpp"
 #include "aircraft_manager.hpp"
+#include "profiler.hpp"
 
 class Airport : public GL::Displayable, public GL::DynamicObject
 {
@@ -11,11 +12,12 @@ private:
     const Point3D m_pos;
     const GL::Texture2D m_texture;
     std::vector<Terminal> m_terminals;
+    FreeTerminals m_free_terminals;
     Tower m_tower;
 
     float m_fuel_stock = 0.f;
     float m_ordered_fuel = 0.f;
-    int m_next_refill_time = 0;
+    float m_next_refill_time = 0.f; // seconds until the next fuel order
 
     const AircraftManager& m_aircraft_manager;
 
@@ -26,13 +28,10 @@ private:
     // otherwise, return an empty waypoint-vector and any number
     std::pair<WaypointQueue, size_t> reserve_terminal(Aircraft& aircraft)
     {
-        const auto it =
-            std::find_if(m_terminals.begin(), m_terminals.end(), [](const Terminal& t) { return !t.in_use(); });
-
-        if (it != m_terminals.end())
+        if (m_free_terminals.any())
         {
-            it->assign_craft(aircraft);
-            const auto term_idx = std::distance(m_terminals.begin(), it);
+            const auto term_idx = m_free_terminals.first();
+            m_terminals[term_idx].assign_craft(aircraft);
             return { m_type.air_to_terminal(m_pos, 0, term_idx), term_idx };
         }
         else
@@ -41,6 +40,8 @@ private:
         }
     }
 
+    bool has_free_terminal() const { return m_free_terminals.any(); }
+
     WaypointQueue start_path(const size_t terminal_number)
     {
         return m_type.terminal_to_air(m_pos, 0, terminal_number);
@@ -62,30 +63,38 @@ private:
             required_fuel -= m_fuel_stock;
             m_ordered_fuel = required_fuel > GL::max_truck_load ? GL::max_truck_load : required_fuel;
             m_fuel_stock += m_ordered_fuel;
-            std::cout << "Ordered " << m_ordered_fuel << " liters of fuel. Current fuel: " << m_fuel_stock << " liters." << std::endl;
-            m_next_refill_time = 100.;
+            events::logger.log(events::Kind::fuel_order, flights::NONE, m_pos, m_ordered_fuel, m_fuel_stock);
+            // a truck every 100 ticks at the default speed
+            m_next_refill_time = 100.f / DEFAULT_TICKS_PER_SEC;
         }
     }
 
 public:
-    Airport(const AirportType& type_, const Point3D& pos_, const img::Image* image, const AircraftManager& aircraft_manager_, const float z_ = 1.0f) :
+    // sprite may be null (no texture)
+    Airport(const AirportType& type_, const Point3D& pos_, const MediaPath* sprite, const AircraftManager& aircraft_manager_, const float z_ = 1.0f) :
         GL::Displayable { z_ },
         m_type { type_ },
         m_pos { pos_ },
-        m_texture { image },
+        m_texture { sprite },
         m_terminals { m_type.create_terminals() },
         m_tower { *this },
         m_aircraft_manager { aircraft_manager_ }
     {
+        m_free_terminals.reset(m_terminals.size());
+        for (size_t index = 0; index < m_terminals.size(); ++index)
+        {
+            m_terminals[index].attach(m_free_terminals, index);
+        }
+
         GL::display_queue.emplace_back(this);
-        GL::move_queue.emplace(this);
+        GL::move_queue.emplace_back(this);
     }
 
     ~Airport()
     {
         const GL::Displayable* tmp = dynamic_cast<const Displayable*>(this);
         GL::display_queue.erase(std::remove(GL::display_queue.begin(), GL::display_queue.end(), tmp));
-        GL::move_queue.erase(this);
+        GL::move_queue.erase(std::remove(GL::move_queue.begin(), GL::move_queue.end(), this));
     }
 
     Tower& get_tower() { return m_tower; }
@@ -94,6 +103,7 @@ public:
 
     void move(double delta_time) override
     {
+        PROFILE_SCOPE(airport);
         manage_fuel(delta_time);
         for (auto& t : m_terminals)
         {
@@ -13,12 +13,12 @@ private:
     const std::vector<Runway> m_runways;
 
 public:
-    AirportType(const Point3D& crossing_pos_, const Point3D& gateway_pos_,
-                std::initializer_list<Point3D> terminal_pos_, std::initializer_list<Runway> runways_) :
+    AirportType(const Point3D& crossing_pos_, const Point3D& gateway_pos_, std::vector<Point3D> terminal_pos_,
+                std::vector<Runway> runways_) :
         m_crossing_pos { crossing_pos_ },
         m_gateway_pos { gateway_pos_ },
-        m_terminal_pos { terminal_pos_ },
-        m_runways { runways_ }
+        m_terminal_pos { std::move(terminal_pos_) },
+        m_runways { std::move(runways_) }
     {}
 
     std::vector<Terminal> create_terminals() const
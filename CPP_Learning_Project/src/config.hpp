@@ -1,6 +1,6 @@
 #pragma once
 
-#include <stdexcept>
+#include <cstdint>
 
 #include "img/media_path.hpp"
 #include "geometry.hpp"
@@ -8,45 +8,50 @@
 const MediaPath one_lane_airport_sprite_path = { "airport_1lane.png" };
 const MediaPath two_lane_airport_sprite_path = { "airport_2lane.png" };
 
-// number of cycles needed to service an aircraft at a terminal
+// number of ticks needed to service an aircraft at a terminal
 constexpr unsigned int SERVICE_CYCLES = 40u;
 // speeds below the threshold speed loose altitude linearly
 constexpr float SPEED_THRESHOLD = 0.05f;
-// this models the speed with wich slow (speed < SPEED_THRESHOLD) aircrafts sink
+// this models the speed with wich slow (speed < SPEED_THRESHOLD) aircrafts sink, per tick
 constexpr float SINK_FACTOR = 0.1f;
 // distances below this distance are considered equal (planes crash, waypoints
 // are reached, etc)
 constexpr float DISTANCE_THRESHOLD = 0.08f;
+// two flying aircrafts closer than this (but not crashing) are a near miss
+constexpr float NEAR_MISS_DISTANCE = 2.f * DISTANCE_THRESHOLD;
+// fuel burnt by an aircraft on every tick
+constexpr float FUEL_CONSUMPTION = 0.5f;
+// aircrafts with less fuel than this get refilled at their terminal
+constexpr float LOW_FUEL = 400.f;
 // each aircraft sprite has 8 tiles
 constexpr unsigned char NUM_AIRCRAFT_TILES = 8;
 // size of the plane-sprite on screen
 constexpr float PLANE_TEXTURE_DIM = 0.2f;
 // default number of ticks per second
 constexpr unsigned int DEFAULT_TICKS_PER_SEC = 16u;
+// the amounts given per tick (SERVICE_CYCLES, SINK_FACTOR, FUEL_CONSUMPTION, the
+// acceleration of the aircraft types) are those of a tick at DEFAULT_TICKS_PER_SEC:
+// a step of delta_time seconds counts for this many of them, whatever the substeps
+constexpr float default_ticks_in(const double delta_time)
+{
+    return static_cast<float>(delta_time * DEFAULT_TICKS_PER_SEC);
+}
+// a display tick runs at most this many ticks worth of simulation steps (late steps are dropped)
+constexpr unsigned int DEFAULT_MAX_CATCH_UP_TICKS = 4u;
+// width and height of the texture holding every sprite (see GL::TextureAtlas)
+constexpr unsigned int TEXTURE_ATLAS_SIZE = 1024u;
 // default zoom factor
 constexpr float DEFAULT_ZOOM = 2.0f;
 // default window dimensions
 constexpr size_t DEFAULT_WINDOW_WIDTH  = 800;
 constexpr size_t DEFAULT_WINDOW_HEIGHT = 600;
 
-// using AircraftCrash = std::runtime_error;
-class AircraftCrash : public std::runtime_error
+// why an aircraft crashed: updates return it rather than throwing, and the
+// message is only formatted when the crash is logged (see events::Logger)
+enum class CrashReason : uint8_t
 {
-public:
-    AircraftCrash(const std::string& flight_number, const Point3D& pos, const Point3D& speed, const std::string& reason) throw()
-        : runtime_error { build_error_msg(flight_number, pos, speed, reason) }
-    {}
-
-private:
-    static std::string build_error_msg(const std::string& flight_number, const Point3D& pos, const Point3D& speed, const std::string& reason)
-    {
-        using namespace std::string_literals;
-        std::string msg;
-        
-        msg += "Aircraft " + flight_number + " has crashed at position ";
-        msg += pos.to_string() + " with speed " + speed.to_string();
-        msg += " because of: " + reason;
-
-        return msg;
-    }
+    none,
+    out_of_fuel,
+    bad_landing,
+    collision,
 };
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "event_log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace events {
+
+namespace {
+
+const char* to_string(const CrashReason reason)
+{
+    switch (reason)
+    {
+    case CrashReason::none:
+        break;
+    case CrashReason::out_of_fuel:
+        return "out of fuel";
+    case CrashReason::bad_landing:
+        return "bad landing";
+    case CrashReason::collision:
+        return "collision with ";
+    }
+    return "unknown";
+}
+
+// one line on std::cout, or on std::cerr for the crashes
+void print(const Event& event)
+{
+    const auto flight = flights::format(event.flight);
+
+    if (event.kind == Kind::crash)
+    {
+        std::cerr << '[' << event.tick << "] Aircraft " << flight.data() << " has crashed at position "
+                  << event.pos.to_string() << " with speed " << event.speed.to_string()
+                  << " because of: " << to_string(event.reason) << flights::format(event.other).data() << std::endl;
+        return;
+    }
+
+    std::cout << '[' << event.tick << "] ";
+    switch (event.kind)
+    {
+    case Kind::lift_off:
+        std::cout << flight.data() << " lift off";
+        break;
+    case Kind::landing:
+        std::cout << flight.data() << " is now landing...";
+        break;
+    case Kind::service_start:
+        std::cout << "now servicing " << flight.data() << "...";
+        break;
+    case Kind::service_done:
+        std::cout << "done servicing " << flight.data();
+        break;
+    case Kind::service_abort:
+        std::cout << "Aborting servicing " << flight.data() << " because it crashed";
+        break;
+    case Kind::refill:
+        std::cout << "Refilling " << event.amount << " liters of fuel to aircraft " << flight.data() << ".";
+        break;
+    case Kind::fuel_order:
+        std::cout << "Ordered " << event.amount << " liters of fuel. Current fuel: " << event.stock << " liters.";
+        break;
+    case Kind::near_miss:
+        std::cout << "Near miss between " << flight.data() << " and " << flights::format(event.other).data()
+                  << " at position " << event.pos.to_string();
+        break;
+    case Kind::crash:
+        break;
+    }
+    std::cout << '\n';
+}
+
+} // namespace
+
+Event* Logger::reserve(const Kind kind, const flights::Id flight, const Point3D& pos)
+{
+    // nobody would print the event before start()
+    if (!enabled(kind) || !m_thread.joinable())
+    {
+        return nullptr;
+    }
+
+    const auto head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) == CAPACITY)
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Event& event = m_ring[head & (CAPACITY - 1)];
+    event.tick   = m_tick;
+    event.kind   = kind;
+    event.flight = flight;
+    event.pos    = pos;
+    return &event;
+}
+
+void Logger::log(const Kind kind, const flights::Id flight, const Point3D& pos, const float amount,
+                 const float stock)
+{
+    if (Event* event = reserve(kind, flight, pos))
+    {
+        event->amount = amount;
+        event->stock  = stock;
+        commit();
+    }
+}
+
+void Logger::log_crash(const flights::Id flight, const Point3D& pos, const Point3D& speed,
+                       const CrashReason reason, const flights::Id other)
+{
+    if (Event* event = reserve(Kind::crash, flight, pos))
+    {
+        event->speed  = speed;
+        event->reason = reason;
+        event->other  = other;
+        commit();
+    }
+}
+
+void Logger::log_near_miss(const flights::Id flight, const Point3D& pos, const flights::Id other)
+{
+    if (Event* event = reserve(Kind::near_miss, flight, pos))
+    {
+        event->other = other;
+        commit();
+    }
+}
+
+void Logger::flush()
+{
+    while (m_thread.joinable() && m_tail.load(std::memory_order_acquire) != m_head.load(std::memory_order_relaxed))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+    }
+}
+
+void Logger::start()
+{
+    if (m_thread.joinable())
+    {
+        return;
+    }
+    m_ring   = std::make_unique<Event[]>(CAPACITY);
+    m_thread = std::thread { [this]() { run(); } };
+}
+
+void Logger::stop()
+{
+    if (m_thread.joinable())
+    {
+        m_stop = true;
+        m_thread.join();
+    }
+}
+
+void Logger::run()
+{
+    while (!m_stop)
+    {
+        if (!drain())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds { 2 });
+        }
+    }
+    drain();
+}
+
+bool Logger::drain()
+{
+    const auto head = m_head.load(std::memory_order_acquire);
+    auto tail       = m_tail.load(std::memory_order_relaxed);
+    if (tail == head)
+    {
+        return false;
+    }
+
+    // a burst must not fill the ring while it is being printed: the slots go back to
+    // the producer a chunk at a time, once printed, so that flush() returns after the output
+    while (tail != head)
+    {
+        const auto end = tail + std::min(head - tail, DRAIN_CHUNK);
+        for (; tail != end; ++tail)
+        {
+            print(m_ring[tail & (CAPACITY - 1)]);
+        }
+
+        if (const auto dropped = m_dropped.exchange(0); dropped != 0)
+        {
+            std::cout << dropped << " events dropped (log buffer full)\n";
+        }
+        std::cout.flush();
+        m_tail.store(tail, std::memory_order_release);
+    }
+    return true;
+}
+
+} // namespace events
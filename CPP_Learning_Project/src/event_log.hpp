@@ -0,0 +1,111 @@
+#pragma once
+
+#include "config.hpp"
+#include "flight_numbers.hpp"
+#include "geometry.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// asynchronous event log: the simulation pushes small typed records into a
+// lock-free ring buffer, a background thread formats and prints them
+// logging never allocates nor blocks the simulation: when the ring is full,
+// events are dropped (and counted)
+// there must be a single producer, the thread running the simulation, and the
+// logger must be started before it runs (events logged before are ignored)
+
+namespace events {
+
+enum class Verbosity
+{
+    off,
+    crashes, // only crashes and near misses
+    all,
+};
+
+enum class Kind : uint8_t
+{
+    lift_off,
+    landing,
+    service_start,
+    service_done,
+    service_abort,
+    refill,
+    fuel_order,
+    crash,
+    near_miss,
+};
+
+struct Event
+{
+    uint64_t tick;
+    Kind kind;
+    flights::Id flight; // NONE for airport events
+    Point3D pos;
+    float amount; // liters refilled or ordered
+    float stock;  // airport fuel stock after an order
+    // crashes only
+    Point3D speed;
+    CrashReason reason;
+    flights::Id other; // flight collided with or missed, NONE otherwise
+};
+
+class Logger
+{
+public:
+    Logger() = default;
+    ~Logger() { stop(); }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void set_verbosity(const Verbosity verbosity) { m_verbosity = verbosity; }
+    bool enabled(const Kind kind) const
+    {
+        return m_verbosity == Verbosity::all ||
+               (m_verbosity == Verbosity::crashes && (kind == Kind::crash || kind == Kind::near_miss));
+    }
+
+    void new_tick() { ++m_tick; }
+
+    void log(const Kind kind, const flights::Id flight, const Point3D& pos, const float amount = 0.f,
+             const float stock = 0.f);
+    // printed to std::cerr
+    void log_crash(const flights::Id flight, const Point3D& pos, const Point3D& speed, const CrashReason reason,
+                   const flights::Id other = flights::NONE);
+    void log_near_miss(const flights::Id flight, const Point3D& pos, const flights::Id other);
+
+    // allocates the ring and starts the printing thread, does nothing if already started
+    void start();
+    // waits until every event logged so far has been printed
+    void flush();
+    void stop();
+
+private:
+    static constexpr size_t CAPACITY = 1 << 14; // a power of 2
+    // the printing thread hands the slots back to the producer after this many events
+    static constexpr size_t DRAIN_CHUNK = 64;
+
+    Verbosity m_verbosity = Verbosity::all;
+    uint64_t m_tick       = 0;
+
+    std::unique_ptr<Event[]> m_ring;
+    std::atomic<size_t> m_head    = 0; // next slot written by the producer
+    std::atomic<size_t> m_tail    = 0; // next slot read by the consumer
+    std::atomic<size_t> m_dropped = 0;
+    std::atomic<bool> m_stop      = false;
+    std::thread m_thread;
+
+    // next free slot, nullptr if the ring is full
+    Event* reserve(const Kind kind, const flights::Id flight, const Point3D& pos);
+    void commit() { m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+    void run();
+    // prints the pending events, returns false if there were none
+    bool drain();
+};
+
+inline Logger logger;
+
+} // namespace events
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+// a flight number is an airline code followed by a number in [10000, 100000), packed in an
+// integer (airline * NUMBERS_PER_AIRLINE + number - FIRST_NUMBER): it is only turned into
+// text when it is displayed
+// five digits give 630000 flights, enough for the largest fleets of tower_bench
+
+namespace flights {
+
+using Id = uint32_t;
+
+// not a flight (airport events)
+constexpr Id NONE = ~Id { 0 };
+
+constexpr std::array<std::string_view, 7> AIRLINES = { "AF", "LH", "EY", "DL", "KL", "BA", "AY" };
+constexpr size_t NUM_DIGITS      = 5;
+constexpr Id FIRST_NUMBER        = 10000;
+constexpr Id NUMBERS_PER_AIRLINE = 90000;
+constexpr Id COUNT               = AIRLINES.size() * NUMBERS_PER_AIRLINE;
+
+constexpr size_t airline(const Id id)
+{
+    return id / NUMBERS_PER_AIRLINE;
+}
+
+// null-terminated text of the flight number ("AF12345"), empty for NONE
+inline std::array<char, 8> format(const Id id)
+{
+    static_assert(2 + NUM_DIGITS < 8);
+    std::array<char, 8> text {};
+    if (id == NONE)
+    {
+        return text;
+    }
+
+    const auto code = AIRLINES[airline(id)];
+    auto number     = id % NUMBERS_PER_AIRLINE + FIRST_NUMBER;
+    text[0]         = code[0];
+    text[1]         = code[1];
+    for (size_t digit = 1 + NUM_DIGITS; digit >= 2; --digit, number /= 10)
+    {
+        text[digit] = static_cast<char>('0' + number % 10);
+    }
+    return text;
+}
+
+// hands out the flight numbers not in use, in random order: the free ones are kept in a
+// shuffled list, a released number is put back at a random place of the list
+class Allocator
+{
+public:
+    Allocator() { seed(std::random_device {}()); }
+
+    // also forgets the numbers in use
+    void seed(const unsigned int seed_)
+    {
+        m_rengine.seed(seed_);
+        m_free.resize(COUNT);
+        std::iota(m_free.rbegin(), m_free.rend(), Id { 0 });
+        std::shuffle(m_free.begin(), m_free.end(), m_rengine);
+        m_used.reset();
+    }
+
+    [[nodiscard]] Id allocate()
+    {
+        if (m_free.empty())
+        {
+            throw std::runtime_error { "No flight number left" };
+        }
+
+        const auto id = m_free.back();
+        m_free.pop_back();
+        m_used.set(id);
+        return id;
+    }
+
+    void release(const Id id)
+    {
+        if (!m_used.test(id))
+        {
+            throw std::logic_error { "Releasing a flight number that is not in use" };
+        }
+
+        m_used.reset(id);
+        // never reallocates: m_free once held every number
+        m_free.emplace_back(id);
+        const auto index = std::uniform_int_distribution<size_t> { 0, m_free.size() - 1 }(m_rengine);
+        std::swap(m_free[index], m_free.back());
+    }
+
+    bool is_used(const Id id) const { return m_used.test(id); }
+    size_t count_used() const { return m_used.count(); }
+
+private:
+    std::mt19937 m_rengine;
+    std::vector<Id> m_free;
+    std::bitset<COUNT> m_used;
+};
+
+} // namespace flights
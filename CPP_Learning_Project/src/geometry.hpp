@@ -5,9 +5,50 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
-
-#include <algorithm>
 #include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+// with SSE, float points of up to 4 dimensions (Point2D, Point3D) are padded to 4 lanes,
+// kept at 0, and computed 4 lanes at a time; without (TOWER_NO_SIMD or no SSE2), they
+// keep their dim values and go through the generic loops, as padding would only add work
+// both sum the squares in the same order: they give the same results, to the bit
+#if (defined(__SSE2__) || defined(_M_X64)) && !defined(TOWER_NO_SIMD)
+#define TOWER_SIMD 1
+#include <immintrin.h>
+#else
+#define TOWER_SIMD 0
+#endif
+
+namespace lanes {
+
+constexpr size_t COUNT = 4;
+
+#if TOWER_SIMD
+inline void add(float* a, const float* b) { _mm_store_ps(a, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b))); }
+inline void sub(float* a, const float* b) { _mm_store_ps(a, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b))); }
+inline void mul(float* a, const float* b) { _mm_store_ps(a, _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b))); }
+inline void scale(float* a, const float s) { _mm_store_ps(a, _mm_mul_ps(_mm_load_ps(a), _mm_set1_ps(s))); }
+
+// ((a0² + a1²) + a2²) + a3²
+inline float sum_of_squares(const float* a)
+{
+    const __m128 squares = _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(a));
+    __m128 sum           = _mm_add_ss(squares, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(1, 1, 1, 1)));
+    sum                  = _mm_add_ss(sum, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(2, 2, 2, 2)));
+    sum                  = _mm_add_ss(sum, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(3, 3, 3, 3)));
+    return _mm_cvtss_f32(sum);
+}
+#else
+// only declared, for the discarded branches of Point: points are not padded without SSE
+void add(float* a, const float* b);
+void sub(float* a, const float* b);
+void mul(float* a, const float* b);
+void scale(float* a, const float s);
+float sum_of_squares(const float* a);
+#endif
+
+} // namespace lanes
 
 template <size_t dim, typename T>
 class Point
@@ -22,7 +63,11 @@ public:
         static_assert(sizeof...(args) + 1 == dim, "Number of args does not match with the dimension");
     }
 
-    std::array<T, dim> values;
+    // padded to lanes::COUNT values with SSE, see lanes
+    static constexpr bool padded = TOWER_SIMD && std::is_same_v<T, float> && dim <= lanes::COUNT;
+    static constexpr size_t num_values = padded ? lanes::COUNT : dim;
+
+    alignas(padded ? 16 : alignof(T)) std::array<T, num_values> values {};
 
     float& x() { return values[0]; }
     float x() const { return values[0]; }
@@ -35,7 +80,14 @@ public:
 
     Point& operator*=(const Point& other)
     {
-        std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::multiplies<float>());
+        if constexpr (padded)
+        {
+            lanes::mul(values.data(), other.values.data());
+        }
+        else
+        {
+            std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::multiplies<float>());
+        }
         return *this;
     }
 
@@ -62,19 +114,40 @@ public:
 
     Point& operator+=(const Point& other)
     {
-        std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::plus<float>());
+        if constexpr (padded)
+        {
+            lanes::add(values.data(), other.values.data());
+        }
+        else
+        {
+            std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::plus<float>());
+        }
         return *this;
     }
 
     Point& operator-=(const Point& other)
     {
-        std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::minus<float>());
+        if constexpr (padded)
+        {
+            lanes::sub(values.data(), other.values.data());
+        }
+        else
+        {
+            std::transform(values.begin(), values.end(), other.values.begin(), values.begin(), std::minus<float>());
+        }
         return *this;
     }
 
     Point& operator*=(const T scalar)
     {
-        std::transform(values.begin(), values.end(), values.begin(), [scalar](float v) { return v * scalar; });
+        if constexpr (padded)
+        {
+            lanes::scale(values.data(), scalar);
+        }
+        else
+        {
+            std::transform(values.begin(), values.end(), values.begin(), [scalar](float v) { return v * scalar; });
+        }
         return *this;
     }
 
@@ -94,7 +167,15 @@ public:
 
     float length() const
     {
-        return std::sqrt(std::reduce(values.begin(), values.end(), 0.f, [](T v1, T v2) { return v1 + (v2 * v2); }));
+        if constexpr (padded)
+        {
+            return std::sqrt(lanes::sum_of_squares(values.data()));
+        }
+        else
+        {
+            // from left to right, like lanes::sum_of_squares
+            return std::sqrt(std::accumulate(values.begin(), values.end(), 0.f, [](T v1, T v2) { return v1 + (v2 * v2); }));
+        }
     }
 
     float distance_to(const Point& other) const { return (*this - other).length(); }
@@ -126,10 +207,11 @@ public:
     std::string to_string() const
     {
         std::string str = "(";
-        for(auto it = values.begin(); it != values.end(); ++it)
+        const auto end  = values.begin() + dim;
+        for(auto it = values.begin(); it != end; ++it)
         {
             str += std::to_string(*it);
-            if(it+1 != values.end())
+            if(it+1 != end)
             {
                 str += ", ";
             }
@@ -142,6 +224,26 @@ private:
 using Point3D = Point<3, float>;
 using Point2D = Point<2, float>;
 
+// batch versions, over arrays of points
+
+// points[i] += directions[i] * factor
+inline void translate(Point3D* points, const Point3D* directions, const float factor, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        points[i] += directions[i] * factor;
+    }
+}
+
+// lengths[i] = points[i].length()
+inline void lengths(const Point3D* points, float* lengths, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        lengths[i] = points[i].length();
+    }
+}
+
 // our 3D-coordinate system will be tied to the airport: the runway is parallel to the x-axis, the z-axis
 // points towards the sky, and y is perpendicular to both thus,
 // {1,0,0} --> {.5,.5}   {0,1,0} --> {-.5,.5}   {0,0,1} --> {0,1}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// binary min-heap of (key, id) pairs that also knows where each id sits, so
+// that any entry can be removed or re-keyed in O(log n)
+// ids are small integers (such as store handles), ties are broken by id
+
+template <typename Key>
+class IndexedHeap
+{
+public:
+    using Id = uint32_t;
+
+    bool empty() const { return m_heap.empty(); }
+    size_t size() const { return m_heap.size(); }
+    bool contains(const Id id) const { return id < m_pos.size() && m_pos[id] != NONE; }
+
+    Id top() const
+    {
+        assert(!empty());
+        return m_heap.front().id;
+    }
+
+    void push(const Id id, const Key& key)
+    {
+        assert(!contains(id));
+        if (id >= m_pos.size())
+        {
+            m_pos.resize(id + 1, NONE);
+        }
+        m_heap.push_back({ key, id });
+        m_pos[id] = m_heap.size() - 1;
+        sift_up(m_heap.size() - 1);
+    }
+
+    void update(const Id id, const Key& key)
+    {
+        assert(contains(id));
+        const auto pos  = m_pos[id];
+        m_heap[pos].key = key;
+        sift_up(pos);
+        sift_down(m_pos[id]);
+    }
+
+    void remove(const Id id)
+    {
+        assert(contains(id));
+        const auto pos  = m_pos[id];
+        const auto last = m_heap.size() - 1;
+        swap_entries(pos, last);
+        m_heap.pop_back();
+        m_pos[id] = NONE;
+        if (pos != last)
+        {
+            sift_up(pos);
+            sift_down(m_pos[m_heap[pos].id]);
+        }
+    }
+
+    void pop() { remove(top()); }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Id id;
+    };
+
+    static constexpr size_t NONE = ~size_t { 0 };
+
+    std::vector<Entry> m_heap;
+    std::vector<size_t> m_pos; // id -> position in m_heap
+
+    static bool before(const Entry& a, const Entry& b) { return a.key < b.key || (!(b.key < a.key) && a.id < b.id); }
+
+    void swap_entries(const size_t a, const size_t b)
+    {
+        std::swap(m_heap[a], m_heap[b]);
+        m_pos[m_heap[a].id] = a;
+        m_pos[m_heap[b].id] = b;
+    }
+
+    void sift_up(size_t pos)
+    {
+        while (pos > 0)
+        {
+            const auto parent = (pos - 1) / 2;
+            if (!before(m_heap[pos], m_heap[parent]))
+            {
+                break;
+            }
+            swap_entries(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void sift_down(size_t pos)
+    {
+        while (true)
+        {
+            const auto left  = 2 * pos + 1;
+            const auto right = left + 1;
+            auto smallest    = pos;
+            if (left < m_heap.size() && before(m_heap[left], m_heap[smallest]))
+            {
+                smallest = left;
+            }
+            if (right < m_heap.size() && before(m_heap[right], m_heap[smallest]))
+            {
+                smallest = right;
+            }
+            if (smallest == pos)
+            {
+                break;
+            }
+            swap_entries(pos, smallest);
+            pos = smallest;
+        }
+    }
+};
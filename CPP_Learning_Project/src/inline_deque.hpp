@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+
+// double-ended queue of at most Capacity elements, stored inline in a ring:
+// creating, copying or growing it never allocates
+// it offers the subset of std::deque the simulation needs
+
+template <typename T, size_t Capacity>
+class InlineDeque
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+private:
+    alignas(T) std::byte m_storage[Capacity * sizeof(T)];
+    size_t m_head = 0;
+    size_t m_size = 0;
+
+    T* slot(const size_t index) { return std::launder(reinterpret_cast<T*>(m_storage)) + ((m_head + index) & (Capacity - 1)); }
+    const T* slot(const size_t index) const
+    {
+        return std::launder(reinterpret_cast<const T*>(m_storage)) + ((m_head + index) & (Capacity - 1));
+    }
+
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+        using Container         = std::conditional_t<Const, const InlineDeque, InlineDeque>;
+
+        Iterator() = default;
+        Iterator(Container* container_, const size_t index_) : container { container_ }, index { index_ } {}
+
+        reference operator*() const { return (*container)[index]; }
+        pointer operator->() const { return &(*container)[index]; }
+
+        Iterator& operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ++index;
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const { return index == other.index && container == other.container; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        Container* container = nullptr;
+        size_t index         = 0;
+    };
+
+public:
+    using value_type     = T;
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    InlineDeque() = default;
+
+    InlineDeque(std::initializer_list<T> values)
+    {
+        for (const auto& value : values)
+        {
+            push_back(value);
+        }
+    }
+
+    InlineDeque(const InlineDeque& other)
+    {
+        for (const auto& value : other)
+        {
+            push_back(value);
+        }
+    }
+
+    InlineDeque& operator=(const InlineDeque& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            for (const auto& value : other)
+            {
+                push_back(value);
+            }
+        }
+        return *this;
+    }
+
+    ~InlineDeque() { clear(); }
+
+    static constexpr size_t capacity() { return Capacity; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    T& operator[](const size_t index)
+    {
+        assert(index < m_size);
+        return *slot(index);
+    }
+
+    const T& operator[](const size_t index) const
+    {
+        assert(index < m_size);
+        return *slot(index);
+    }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[m_size - 1]; }
+    const T& back() const { return (*this)[m_size - 1]; }
+
+    iterator begin() { return { this, 0 }; }
+    iterator end() { return { this, m_size }; }
+    const_iterator begin() const { return { this, 0 }; }
+    const_iterator end() const { return { this, m_size }; }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        assert(m_size < Capacity);
+        T* const value = new (slot(m_size)) T { std::forward<Args>(args)... };
+        ++m_size;
+        return *value;
+    }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args)
+    {
+        assert(m_size < Capacity);
+        m_head = (m_head + Capacity - 1) & (Capacity - 1);
+        ++m_size;
+        return *new (slot(0)) T { std::forward<Args>(args)... };
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_front(const T& value) { emplace_front(value); }
+
+    void pop_front()
+    {
+        assert(!empty());
+        slot(0)->~T();
+        m_head = (m_head + 1) & (Capacity - 1);
+        --m_size;
+    }
+
+    void pop_back()
+    {
+        assert(!empty());
+        slot(m_size - 1)->~T();
+        --m_size;
+    }
+
+    void clear()
+    {
+        while (!empty())
+        {
+            pop_back();
+        }
+        m_head = 0;
+    }
+};
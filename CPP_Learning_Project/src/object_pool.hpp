@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// slab allocator: objects are constructed in blocks of BlockSize slots, and the slots
+// of destroyed objects are recycled (last freed, first reused) instead of going back
+// to the heap; once the pool has grown to the peak population, creating and destroying
+// objects never allocates
+// blocks are only released with the pool, which must outlive its objects
+
+template <typename T, size_t BlockSize = 256> class ObjectPool
+{
+public:
+    // lets a std::unique_ptr give its object back to the pool
+    struct Deleter
+    {
+        ObjectPool* pool = nullptr;
+        void operator()(T* object) const { pool->destroy(object); }
+    };
+    using Ptr = std::unique_ptr<T, Deleter>;
+
+    ObjectPool() = default;
+    ~ObjectPool() { assert(m_live == 0); }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args> [[nodiscard]] Ptr make(Args&&... args)
+    {
+        if (m_free.empty())
+        {
+            grow();
+        }
+
+        // the slot stays free if the constructor throws
+        T* object = new (m_free.back()) T(std::forward<Args>(args)...);
+        m_free.pop_back();
+        m_peak = std::max(m_peak, ++m_live);
+        return Ptr { object, Deleter { this } };
+    }
+
+    void destroy(T* object)
+    {
+        object->~T();
+        // never reallocates: m_free can hold every slot
+        m_free.emplace_back(object);
+        --m_live;
+    }
+
+    size_t live() const { return m_live; }
+    // highest number of objects alive at once
+    size_t peak() const { return m_peak; }
+    size_t capacity() const { return m_blocks.size() * BlockSize; }
+
+private:
+    struct alignas(T) Slot
+    {
+        std::byte bytes[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> m_blocks;
+    std::vector<void*> m_free;
+    size_t m_live = 0;
+    size_t m_peak = 0;
+
+    void grow()
+    {
+        Slot* block = m_blocks.emplace_back(new Slot[BlockSize]).get();
+        m_free.reserve(capacity());
+        // the first slot of the block is reused first
+        for (size_t i = BlockSize; i-- > 0;)
+        {
+            m_free.emplace_back(&block[i]);
+        }
+    }
+};
@@ -0,0 +1,91 @@
+#include "profiler.hpp"
+
+#include <iomanip>
+#include <ostream>
+
+namespace profiling {
+
+namespace {
+
+constexpr std::array<std::pair<const char*, double>, 4> QUANTILES = {
+    { { "p50", 0.5 }, { "p90", 0.9 }, { "p99", 0.99 }, { "p999", 0.999 } }
+};
+
+}
+
+void Profiler::print(std::ostream& stream) const
+{
+#ifdef TOWER_NO_PROFILER
+    stream << "The profiler was compiled out (TOWER_NO_PROFILER)." << std::endl;
+#endif
+
+    const auto flags     = stream.flags();
+    const auto precision = stream.precision();
+    stream << std::left << std::setw(20) << "phase (us)" << std::right << std::setw(10) << "calls" << std::setw(10)
+           << "mean";
+    for (const auto& [name, q] : QUANTILES)
+    {
+        stream << std::setw(10) << name;
+    }
+    stream << std::setw(10) << "max" << std::setw(12) << "total" << '\n';
+
+    stream << std::fixed << std::setprecision(1);
+    for (size_t phase = 0; phase < NUM_PHASES; ++phase)
+    {
+        const auto& histogram = m_histograms[phase];
+        if (histogram.count() == 0)
+        {
+            continue;
+        }
+
+        stream << std::left << std::setw(20) << PHASE_NAMES[phase] << std::right << std::setw(10) << histogram.count()
+               << std::setw(10) << histogram.mean() / 1e3;
+        for (const auto& [name, q] : QUANTILES)
+        {
+            stream << std::setw(10) << histogram.quantile(q) / 1e3;
+        }
+        stream << std::setw(10) << histogram.max() / 1e3 << std::setw(12) << histogram.total() / 1e3 << '\n';
+    }
+    stream << std::flush;
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void Profiler::write_json(std::ostream& stream) const
+{
+#ifdef TOWER_NO_PROFILER
+    constexpr bool enabled = false;
+#else
+    constexpr bool enabled = true;
+#endif
+
+    stream << "{\n  \"enabled\": " << (enabled ? "true" : "false") << ",\n  \"unit\": \"ns\",\n  \"phases\": [";
+    for (size_t phase = 0; phase < NUM_PHASES; ++phase)
+    {
+        const auto& histogram = m_histograms[phase];
+        stream << (phase ? ",\n" : "\n") << "    { \"name\": \"" << PHASE_NAMES[phase]
+               << "\", \"count\": " << histogram.count() << ", \"total\": " << histogram.total()
+               << ", \"mean\": " << histogram.mean() << ", \"min\": " << histogram.min()
+               << ", \"max\": " << histogram.max();
+        for (const auto& [name, q] : QUANTILES)
+        {
+            stream << ", \"" << name << "\": " << histogram.quantile(q);
+        }
+
+        // [lowest value, count] of the buckets that were hit
+        stream << ",\n      \"buckets\": [";
+        bool first = true;
+        for (size_t index = 0; index < Histogram::NUM_BUCKETS; ++index)
+        {
+            if (const auto count = histogram.bucket_count(index); count != 0)
+            {
+                stream << (first ? "" : ", ") << '[' << Histogram::lowest(index) << ", " << count << ']';
+                first = false;
+            }
+        }
+        stream << "] }";
+    }
+    stream << "\n  ]\n}" << std::endl;
+}
+
+} // namespace profiling
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+// where the time of a tick goes: scoped timers around the phases of a tick feed one
+// latency histogram per phase, printed with the 'p' key or dumped as JSON by --profile
+// the timers compile to nothing when TOWER_NO_PROFILER is defined
+// a histogram is only written from one thread: the simulation phases from the thread
+// running the simulation, frame_draw from the GLUT thread (which also prints them)
+
+namespace profiling {
+
+enum class Phase : uint8_t
+{
+    tick,                // GL::tick, all the dynamic objects
+    aircraft_update,     // AircraftManager::move: aircraft updates after the kinematics
+    aircraft_kinematics, // AircraftManager::move: fuel and kinematics over the store
+    proximity,           // AircraftManager::move: collisions and near misses
+    aircraft_erase,      // AircraftManager::move: dropping the aircrafts out of the simulation
+    airport,             // Airport::move
+    tower,               // AircraftManager::move: waypoint updates (talking to the tower)
+    frame_sort,          // GL::record_frame: sorting the displayables
+    frame_record,        // GL::record_frame: the displayables drawing into the frame
+    frame_draw,          // GL::display
+};
+constexpr size_t NUM_PHASES = 10;
+
+constexpr std::array<std::string_view, NUM_PHASES> PHASE_NAMES = {
+    "tick", "aircraft_update", "aircraft_kinematics", "proximity", "aircraft_erase",
+    "airport", "tower", "frame_sort", "frame_record", "frame_draw",
+};
+
+// HDR-style histogram of durations in nanoseconds: values below 2 * SUB_BUCKETS have
+// their own bucket, then every power of two is split into SUB_BUCKETS buckets, which
+// keeps the relative error under 1 / SUB_BUCKETS at any scale
+class Histogram
+{
+public:
+    static constexpr unsigned int SUB_BITS = 4;
+    static constexpr uint64_t SUB_BUCKETS  = uint64_t { 1 } << SUB_BITS;
+    // the largest values have a shift of 63 - SUB_BITS
+    static constexpr size_t NUM_BUCKETS = (65 - SUB_BITS) * SUB_BUCKETS;
+
+    static constexpr size_t bucket(const uint64_t value)
+    {
+        const auto width = static_cast<unsigned int>(std::bit_width(value));
+        const auto shift = std::max(width, SUB_BITS + 1) - (SUB_BITS + 1);
+        return shift * SUB_BUCKETS + (value >> shift);
+    }
+    // smallest and largest values falling in the bucket
+    static constexpr uint64_t lowest(const size_t index)
+    {
+        return index < 2 * SUB_BUCKETS ? index
+                                       : (index % SUB_BUCKETS + SUB_BUCKETS) << (index / SUB_BUCKETS - 1);
+    }
+    static constexpr uint64_t highest(const size_t index)
+    {
+        return index < 2 * SUB_BUCKETS ? index : lowest(index) + (uint64_t { 1 } << (index / SUB_BUCKETS - 1)) - 1;
+    }
+
+    void record(const uint64_t value)
+    {
+        ++m_buckets[bucket(value)];
+        ++m_count;
+        m_total += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    uint64_t count() const { return m_count; }
+    uint64_t total() const { return m_total; }
+    uint64_t min() const { return m_count ? m_min : 0; }
+    uint64_t max() const { return m_max; }
+    double mean() const { return m_count ? static_cast<double>(m_total) / m_count : 0.; }
+    uint64_t bucket_count(const size_t index) const { return m_buckets[index]; }
+
+    // largest value of the bucket holding the given quantile (in [0, 1])
+    uint64_t quantile(const double q) const
+    {
+        const auto rank = static_cast<uint64_t>(q * m_count);
+        uint64_t seen   = 0;
+        for (size_t index = 0; index < NUM_BUCKETS; ++index)
+        {
+            seen += m_buckets[index];
+            if (seen > rank)
+            {
+                return std::min(highest(index), m_max);
+            }
+        }
+        return m_max;
+    }
+
+private:
+    std::array<uint64_t, NUM_BUCKETS> m_buckets {};
+    uint64_t m_count = 0;
+    uint64_t m_total = 0;
+    uint64_t m_min   = UINT64_MAX;
+    uint64_t m_max   = 0;
+};
+
+class Profiler
+{
+public:
+    void record(const Phase phase, const uint64_t ns) { m_histograms[static_cast<size_t>(phase)].record(ns); }
+    const Histogram& histogram(const Phase phase) const { return m_histograms[static_cast<size_t>(phase)]; }
+
+    // one line per phase that ran, in microseconds
+    void print(std::ostream& stream) const;
+    // every phase with its statistics (in nanoseconds) and its non-empty buckets
+    void write_json(std::ostream& stream) const;
+
+private:
+    std::array<Histogram, NUM_PHASES> m_histograms;
+};
+
+inline Profiler profiler;
+
+// records the time spent in its scope
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const Phase phase) : m_phase { phase } {}
+    ~ScopedTimer()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        profiler.record(m_phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const Phase m_phase;
+    const std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+};
+
+} // namespace profiling
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b)  PROFILE_CONCAT_(a, b)
+
+// times the rest of the enclosing scope as the given profiling::Phase
+#ifdef TOWER_NO_PROFILER
+#define PROFILE_SCOPE(phase)
+#else
+#define PROFILE_SCOPE(phase) \
+    const profiling::ScopedTimer PROFILE_CONCAT(scoped_timer_, __LINE__) { profiling::Phase::phase }
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "aircraft_store.hpp"
+
+#include <cassert>
+#include <vector>
+
+// terminal reserved by each aircraft, indexed by its store handle
+// handles are small and reused, so a plain vector is an O(1) map that stops
+// allocating once it has grown to the largest fleet
+
+class ReservationTable
+{
+public:
+    using Handle = AircraftStore::Handle;
+
+    static constexpr size_t NONE = ~size_t { 0 };
+
+    void reserve(const Handle handle, const size_t terminal)
+    {
+        if (handle >= m_terminals.size())
+        {
+            m_terminals.resize(handle + 1, NONE);
+        }
+        assert(m_terminals[handle] == NONE);
+        m_terminals[handle] = terminal;
+        ++m_size;
+    }
+
+    // the terminal reserved by the aircraft, or NONE
+    size_t find(const Handle handle) const { return handle < m_terminals.size() ? m_terminals[handle] : NONE; }
+
+    void erase(const Handle handle)
+    {
+        assert(find(handle) != NONE);
+        m_terminals[handle] = NONE;
+        --m_size;
+    }
+
+    size_t size() const { return m_size; }
+
+private:
+    std::vector<size_t> m_terminals;
+    size_t m_size = 0;
+};
@@ -0,0 +1,90 @@
+#include "spatial_grid.hpp"
+
+#include <algorithm>
+
+void SpatialGrid::rebuild(const AircraftStore& store)
+{
+    const auto size = store.size();
+    std::fill(m_slot_of.begin(), m_slot_of.end(), NO_SLOT);
+    m_entries.resize(size);
+    m_entry_cell.resize(size);
+    if (size == 0)
+    {
+        m_dims = {};
+        m_cell_start.assign(1, 0);
+        return;
+    }
+
+    Point3D lo = store.pos(store.handle_at(0)), hi = lo;
+    for (size_t index = 1; index < size; ++index)
+    {
+        const auto& pos = store.pos(store.handle_at(index));
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            lo.values[axis] = std::min(lo.values[axis], pos.values[axis]);
+            hi.values[axis] = std::max(hi.values[axis], pos.values[axis]);
+        }
+    }
+
+    // a few aircrafts far away must not blow the number of cells up
+    const auto max_cells = std::max(MIN_MAX_CELLS, CELLS_PER_AIRCRAFT * size);
+    const auto extent    = hi - lo;
+    const auto volume    = (extent.x() + min_cell_size) * (extent.y() + min_cell_size) * (extent.z() + min_cell_size);
+    m_origin             = lo;
+    m_cell_size          = std::max(min_cell_size, std::cbrt(volume / max_cells));
+    while (true)
+    {
+        size_t num_cells = 1;
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            m_dims[axis] = static_cast<int32_t>(extent.values[axis] / m_cell_size) + 1;
+            num_cells *= m_dims[axis];
+        }
+        if (num_cells <= max_cells)
+        {
+            m_cell_start.assign(num_cells + 1, 0);
+            break;
+        }
+        // the rounding up of the dimensions went over
+        m_cell_size *= 1.1f;
+    }
+
+    // counting sort: count the aircrafts of each cell, then turn the counts into the
+    // first slot of each cell, then scatter the aircrafts (in the order of the store)
+    m_cell_of.resize(size);
+    for (size_t index = 0; index < size; ++index)
+    {
+        const auto cell  = cell_index(clamped_coords(store.pos(store.handle_at(index))));
+        m_cell_of[index] = static_cast<uint32_t>(cell);
+        ++m_cell_start[cell + 1];
+    }
+    for (size_t cell = 1; cell < m_cell_start.size(); ++cell)
+    {
+        m_cell_start[cell] += m_cell_start[cell - 1];
+    }
+    // m_cell_start[cell] is the next free slot of the cell while scattering
+    for (size_t index = 0; index < size; ++index)
+    {
+        const auto handle = store.handle_at(index);
+        const auto slot   = m_cell_start[m_cell_of[index]]++;
+        m_entries[slot]    = { store.pos(handle), handle };
+        m_entry_cell[slot] = m_cell_of[index];
+        if (handle >= m_slot_of.size())
+        {
+            m_slot_of.resize(handle + 1, NO_SLOT);
+        }
+        m_slot_of[handle] = slot;
+    }
+    // m_cell_start[cell] is now where the cell ends, that is where the next one starts
+    std::rotate(m_cell_start.rbegin(), m_cell_start.rbegin() + 1, m_cell_start.rend());
+    m_cell_start[0] = 0;
+}
+
+void SpatialGrid::remove(const Handle handle)
+{
+    if (handle < m_slot_of.size() && m_slot_of[handle] != NO_SLOT)
+    {
+        m_entries[m_slot_of[handle]].handle = NO_HANDLE;
+        m_slot_of[handle]                   = NO_SLOT;
+    }
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "aircraft_store.hpp"
+#include "geometry.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// dense uniform grid over the aircraft positions of a store, rebuilt every tick
+// the cells cover the bounding box of the aircrafts, and a counting sort lays the
+// aircrafts out cell after cell in one flat array (with a copy of their position):
+// a rebuild is three passes over the store with no allocation once the buffers have
+// grown, and a query walks contiguous memory instead of hash buckets
+
+class SpatialGrid
+{
+public:
+    using Handle = AircraftStore::Handle;
+
+    explicit SpatialGrid(const float min_cell_size_) : min_cell_size { min_cell_size_ } {}
+
+    // sorts every aircraft of the store into its cell
+    void rebuild(const AircraftStore& store);
+    // the aircraft is skipped by the queries until the next rebuild
+    void remove(const Handle handle);
+
+    // calls fn(first, second) once for every pair of aircrafts closer than radius
+    // (radius must not exceed the cell size): every cell is only compared with itself
+    // and the 13 neighbours that come after it, so each pair is tested once
+    template <typename Fn>
+    void for_each_pair_within(const float radius, Fn&& fn) const
+    {
+        const auto radius_sq = radius * radius;
+        // only the cells holding an aircraft are visited, they follow each other in m_entries
+        for (uint32_t begin = 0, end = 0; begin < m_entries.size(); begin = end)
+        {
+            const auto cell = m_entry_cell[begin];
+            end             = m_cell_start[cell + 1];
+            const auto x    = static_cast<int32_t>(cell % m_dims[0]);
+            const auto y    = static_cast<int32_t>(cell / m_dims[0] % m_dims[1]);
+            const auto z    = static_cast<int32_t>(cell / m_dims[0] / m_dims[1]);
+
+            for (auto first = begin; first < end; ++first)
+            {
+                for (auto second = first + 1; second < end; ++second)
+                {
+                    test_pair(first, second, radius_sq, fn);
+                }
+            }
+            for (const auto& [dx, dy, dz] : FORWARD_NEIGHBOURS)
+            {
+                const CellCoords other { x + dx, y + dy, z + dz };
+                if (!contains(other))
+                {
+                    continue;
+                }
+                const auto other_cell = cell_index(other);
+                for (auto first = begin; first < end; ++first)
+                {
+                    for (auto second = m_cell_start[other_cell]; second < m_cell_start[other_cell + 1]; ++second)
+                    {
+                        test_pair(first, second, radius_sq, fn);
+                    }
+                }
+            }
+        }
+    }
+
+    // calls fn(handle) for every aircraft within radius of pos, as of the last rebuild
+    template <typename Fn>
+    void for_each_within(const Point3D& pos, const float radius, Fn&& fn) const
+    {
+        if (m_entries.empty())
+        {
+            return;
+        }
+
+        const auto lo = clamped_coords(pos - Point3D { radius, radius, radius });
+        const auto hi = clamped_coords(pos + Point3D { radius, radius, radius });
+        for (auto z = lo[2]; z <= hi[2]; ++z)
+        {
+            for (auto y = lo[1]; y <= hi[1]; ++y)
+            {
+                for (auto x = lo[0]; x <= hi[0]; ++x)
+                {
+                    const auto cell = cell_index({ x, y, z });
+                    for (auto slot = m_cell_start[cell]; slot < m_cell_start[cell + 1]; ++slot)
+                    {
+                        const auto& entry = m_entries[slot];
+                        if (entry.handle != NO_HANDLE && entry.pos.distance_to(pos) < radius)
+                        {
+                            fn(entry.handle);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    using CellCoords = std::array<int32_t, 3>;
+
+    struct Entry
+    {
+        Point3D pos;
+        Handle handle;
+    };
+
+    static constexpr Handle NO_HANDLE   = ~Handle { 0 };
+    static constexpr uint32_t NO_SLOT   = ~uint32_t { 0 };
+    // the cells are cleared at every rebuild: when the aircrafts spread out too much,
+    // the cells grow so that there are at most this many per aircraft (and MIN_MAX_CELLS)
+    static constexpr size_t CELLS_PER_AIRCRAFT = 32;
+    static constexpr size_t MIN_MAX_CELLS      = 1 << 15;
+
+    // the neighbours after (0, 0, 0) in z, y, x order: the other half sees this cell
+    static constexpr std::array<CellCoords, 13> FORWARD_NEIGHBOURS = { {
+        { 1, 0, 0 },
+        { -1, 1, 0 }, { 0, 1, 0 }, { 1, 1, 0 },
+        { -1, -1, 1 }, { 0, -1, 1 }, { 1, -1, 1 },
+        { -1, 0, 1 }, { 0, 0, 1 }, { 1, 0, 1 },
+        { -1, 1, 1 }, { 0, 1, 1 }, { 1, 1, 1 },
+    } };
+
+    const float min_cell_size;
+    float m_cell_size = min_cell_size;
+    Point3D m_origin {};
+    CellCoords m_dims {};
+    std::vector<uint32_t> m_cell_start; // cell -> first slot of the cell in m_entries, one past the end last
+    std::vector<Entry> m_entries;       // sorted by cell
+    std::vector<uint32_t> m_entry_cell; // slot in m_entries -> cell
+    std::vector<uint32_t> m_cell_of;    // store index -> cell, during a rebuild
+    std::vector<uint32_t> m_slot_of;    // handle -> slot in m_entries
+
+    size_t cell_index(const CellCoords& coords) const
+    {
+        return static_cast<size_t>(coords[0]) +
+               static_cast<size_t>(m_dims[0]) * (coords[1] + static_cast<size_t>(m_dims[1]) * coords[2]);
+    }
+
+    bool contains(const CellCoords& coords) const
+    {
+        return coords[0] >= 0 && coords[0] < m_dims[0] && coords[1] >= 0 && coords[1] < m_dims[1] &&
+               coords[2] >= 0 && coords[2] < m_dims[2];
+    }
+
+    int32_t clamped_coord(const float value, const size_t axis) const
+    {
+        const auto coord = std::floor((value - m_origin.values[axis]) / m_cell_size);
+        return coord < 0.f ? 0 : coord >= m_dims[axis] ? m_dims[axis] - 1 : static_cast<int32_t>(coord);
+    }
+
+    CellCoords clamped_coords(const Point3D& pos) const
+    {
+        return { clamped_coord(pos.x(), 0), clamped_coord(pos.y(), 1), clamped_coord(pos.z(), 2) };
+    }
+
+    template <typename Fn>
+    void test_pair(const uint32_t first, const uint32_t second, const float radius_sq, Fn& fn) const
+    {
+        const auto& a = m_entries[first];
+        const auto& b = m_entries[second];
+        if (a.handle == NO_HANDLE || b.handle == NO_HANDLE)
+        {
+            return;
+        }
+        const auto delta = a.pos - b.pos;
+        if (delta.x() * delta.x() + delta.y() * delta.y() + delta.z() * delta.z() < radius_sq)
+        {
+            fn(a.handle, b.handle);
+        }
+    }
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "config.hpp"
+#include "geometry.hpp"
+
+#include <cmath>
+
+// tile of the plane texture facing the given speed: the angle between the speed and
+// the x axis (clockwise when y > 0) is split into NUM_AIRCRAFT_TILES sectors
+// the angle is never computed: x / |speed| is compared with the cosines of the sector
+// bounds, squared so that no sqrt is needed; without trig nor branches, loops over
+// arrays of speeds vectorize
+inline unsigned int speed_octant(const Point3D& speed)
+{
+    static_assert(NUM_AIRCRAFT_TILES == 8);
+    // cos(pi/8)^2 and cos(3pi/8)^2
+    constexpr float COS2_1 = 0.85355339f;
+    constexpr float COS2_3 = 0.14644661f;
+
+    const float len2 = speed.x() * speed.x() + speed.y() * speed.y() + speed.z() * speed.z();
+    // x |x| grows with x: x > k |speed| <=> x |x| > k |k| |speed|^2
+    const float x = speed.x() * std::abs(speed.x());
+
+    // number of quarter turns (rounded) between the speed and the x axis, from 0 to 4
+    const unsigned int quarter = 4u - (x > -COS2_1 * len2) - (x > -COS2_3 * len2) - (x > COS2_3 * len2) -
+                                 (x > COS2_1 * len2);
+    const unsigned int sector = speed.y() > 0 ? (8u - quarter) & 7u : quarter;
+    return len2 > 0 ? (sector + 1u) & 7u : 0u;
+}
+
+// octants[i] = speed_octant(speeds[i]), for the speeds of many aircrafts at once
+inline void speed_octants(const Point3D* speeds, unsigned char* octants, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        octants[i] = static_cast<unsigned char>(speed_octant(speeds[i]));
+    }
+}
@@ -1,49 +1,122 @@
 #pragma once
 
+#include "GL/dynamic_object.hpp"
+#include "event_log.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// bitmask of the free terminals of an airport, so that finding one does not
+// need to look at the terminals themselves
+
+class FreeTerminals
+{
+private:
+    std::vector<uint64_t> m_words;
+    size_t m_count = 0;
+
+public:
+    // all num_terminals terminals start free
+    void reset(const size_t num_terminals)
+    {
+        m_words.assign((num_terminals + 63) / 64, 0);
+        for (size_t index = 0; index < num_terminals; ++index)
+        {
+            set_free(index, true);
+        }
+    }
+
+    bool any() const { return m_count > 0; }
+
+    void set_free(const size_t index, const bool is_free)
+    {
+        auto& word          = m_words[index / 64];
+        const auto bit      = uint64_t { 1 } << (index % 64);
+        const bool was_free = word & bit;
+        if (was_free != is_free)
+        {
+            word ^= bit;
+            is_free ? ++m_count : --m_count;
+        }
+    }
+
+    // lowest free terminal, there must be one
+    size_t first() const
+    {
+        assert(any());
+        size_t word = 0;
+        while (m_words[word] == 0)
+        {
+            ++word;
+        }
+        return word * 64 + std::countr_zero(m_words[word]);
+    }
+};
+
 class Terminal : public GL::DynamicObject
 {
 private:
-    unsigned int m_service_progress    = SERVICE_CYCLES;
+    float m_service_progress     = SERVICE_CYCLES; // in ticks at DEFAULT_TICKS_PER_SEC
     Aircraft* m_current_aircraft = nullptr;
     const Point3D m_pos;
 
+    // the airport's bitmask, kept up to date as aircrafts come and go
+    FreeTerminals* m_free_terminals = nullptr;
+    size_t m_index                  = 0;
+
+    void set_current_aircraft(Aircraft* aircraft)
+    {
+        m_current_aircraft = aircraft;
+        if (m_free_terminals)
+        {
+            m_free_terminals->set_free(m_index, aircraft == nullptr);
+        }
+    }
+
     Terminal(const Terminal&) = delete;
     Terminal& operator=(const Terminal&) = delete;
 
 public:
     Terminal(const Point3D& pos_) : m_pos { pos_ } {}
 
+    void attach(FreeTerminals& free_terminals, const size_t index)
+    {
+        m_free_terminals = &free_terminals;
+        m_index          = index;
+    }
+
     bool in_use() const { return m_current_aircraft != nullptr; }
     bool is_servicing() const { return m_service_progress < SERVICE_CYCLES; }
-    void assign_craft(Aircraft& aircraft) { m_current_aircraft = &aircraft; }
+    void assign_craft(Aircraft& aircraft) { set_current_aircraft(&aircraft); }
 
     void start_service(const Aircraft& aircraft)
     {
         assert(aircraft.distance_to(m_pos) < DISTANCE_THRESHOLD);
-        std::cout << "now servicing " << aircraft.get_flight_num() << "...\n";
+        events::logger.log(events::Kind::service_start, aircraft.get_flight_id(), m_pos);
         m_service_progress = 0;
     }
 
     void abort_service()
     {
-        std::cout << "Aborting servicing " << m_current_aircraft->get_flight_num() << " because it crashed\n";
-        m_current_aircraft = nullptr; 
+        events::logger.log(events::Kind::service_abort, m_current_aircraft->get_flight_id(), m_pos);
+        set_current_aircraft(nullptr);
     }
 
     void finish_service()
     {
         if (!is_servicing())
         {
-            std::cout << "done servicing " << m_current_aircraft->get_flight_num() << '\n';
-            m_current_aircraft = nullptr;
+            events::logger.log(events::Kind::service_done, m_current_aircraft->get_flight_id(), m_pos);
+            set_current_aircraft(nullptr);
         }
     }
 
-    void move(double) override
+    void move(double delta_time) override
     {
         if (in_use() && is_servicing() && !m_current_aircraft->is_low_on_fuel())
         {
-            ++m_service_progress;
+            m_service_progress += default_ticks_in(delta_time);
         }
     }
 
@@ -0,0 +1,121 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(const unsigned int num_threads)
+{
+    const auto count = std::max(1u, num_threads);
+    for (unsigned int id = 0; id < count; ++id)
+    {
+        m_queues.emplace_back(std::make_unique<Queue>());
+    }
+    for (unsigned int id = 1; id < count; ++id)
+    {
+        m_threads.emplace_back([this, id]() { worker(id); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::parallel_for(const size_t count, const size_t grain, const Job& job)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (m_threads.empty() || count <= grain)
+    {
+        job(0, count);
+        return;
+    }
+
+    const auto num_chunks = (count + grain - 1) / grain;
+    m_remaining           = num_chunks;
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+        auto& queue = *m_queues[chunk % m_queues.size()];
+        std::lock_guard<std::mutex> lock { queue.mutex };
+        queue.chunks.push_back({ chunk * grain, std::min(count, (chunk + 1) * grain), &job });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    while (run_one(0))
+    {}
+
+    std::unique_lock<std::mutex> lock { m_mutex };
+    m_done.wait(lock, [this]() { return m_remaining == 0; });
+}
+
+bool ThreadPool::run_one(const unsigned int id)
+{
+    const auto num_queues = m_queues.size();
+    for (size_t i = 0; i < num_queues; ++i)
+    {
+        auto& queue    = *m_queues[(id + i) % num_queues];
+        const bool own = (i == 0);
+
+        std::unique_lock<std::mutex> lock { queue.mutex };
+        if (queue.chunks.empty())
+        {
+            continue;
+        }
+        Chunk chunk;
+        if (own)
+        {
+            chunk = queue.chunks.back();
+            queue.chunks.pop_back();
+        }
+        else
+        {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+        }
+        lock.unlock();
+
+        (*chunk.job)(chunk.begin, chunk.end);
+
+        if (--m_remaining == 0)
+        {
+            std::lock_guard<std::mutex> done_lock { m_mutex };
+            m_done.notify_all();
+        }
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::worker(const unsigned int id)
+{
+    uint64_t seen_generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock { m_mutex };
+            m_wake.wait(lock, [this, seen_generation]() { return m_stop || m_generation != seen_generation; });
+            if (m_stop)
+            {
+                return;
+            }
+            seen_generation = m_generation;
+        }
+
+        while (run_one(id))
+        {}
+    }
+}
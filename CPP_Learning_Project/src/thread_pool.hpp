@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// a small work-stealing pool for data-parallel loops
+// parallel_for splits a range into chunks dealt to one queue per thread; each
+// thread works from the back of its own queue and, once empty, steals from the
+// front of the others. The calling thread takes part in the work.
+
+class ThreadPool
+{
+public:
+    using Job = std::function<void(size_t begin, size_t end)>;
+
+    // num_threads counts the calling thread: a pool of 1 runs everything inline
+    explicit ThreadPool(const unsigned int num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned int size() const { return static_cast<unsigned int>(m_queues.size()); }
+
+    // calls job on chunks of at most grain elements covering [0, count), returns once all are done
+    // job must not throw, and chunks must be independent from each other
+    void parallel_for(const size_t count, const size_t grain, const Job& job);
+
+private:
+    struct Chunk
+    {
+        size_t begin;
+        size_t end;
+        const Job* job;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues; // m_queues[0] belongs to the calling thread
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    uint64_t m_generation = 0;
+    bool m_stop           = false;
+    std::atomic<size_t> m_remaining = 0;
+
+    void worker(const unsigned int id);
+    // runs one chunk, from our own queue or stolen from another one; false if there was none
+    bool run_one(const unsigned int id);
+};
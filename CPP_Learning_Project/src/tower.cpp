@@ -4,22 +4,26 @@
 #include "airport.hpp"
 #include "airport_type.hpp"
 
-WaypointQueue Tower::get_circle() const
+WaypointQueue Tower::get_circle(const Aircraft& aircraft) const
 {
-    return { { Point3D { -1.5f, -1.5f, .5f }, wp_air },
-             { Point3D { 1.5f, -1.5f, .5f }, wp_air },
-             { Point3D { 1.5f, 1.5f, .5f }, wp_air },
-             { Point3D { -1.5f, 1.5f, .5f }, wp_air } };
+    // the slots are DISTANCE_THRESHOLD apart (at least) in size and in altitude
+    const auto slot = aircraft.get_handle() % (HOLDING_SIZES * HOLDING_LEVELS);
+    const float s   = 1.5f + .2f * (slot % HOLDING_SIZES);
+    const float z   = .5f + .1f * (slot / HOLDING_SIZES);
+    return { { Point3D { -s, -s, z }, wp_air },
+             { Point3D { s, -s, z }, wp_air },
+             { Point3D { s, s, z }, wp_air },
+             { Point3D { -s, s, z }, wp_air } };
 }
 
 WaypointQueue Tower::get_instructions(Aircraft& aircraft)
 {
-    if (!aircraft.m_is_at_terminal)
+    if (!aircraft.is_at_terminal())
     {
         const auto path = reserve_terminal(aircraft);
         if(path.empty())
         {
-            return get_circle();
+            return get_circle(aircraft);
         }
         else
         {
@@ -29,22 +33,21 @@ WaypointQueue Tower::get_instructions(Aircraft& aircraft)
     else
     {
         // get a path for the craft to start
-        const auto it = m_reserved_terminals.find(&aircraft);
-        assert(it != m_reserved_terminals.end());
-        const auto terminal_num = it->second;
+        const auto terminal_num = m_reserved_terminals.find(aircraft.get_handle());
+        assert(terminal_num != ReservationTable::NONE);
         Terminal& terminal      = m_airport.get_terminal(terminal_num);
         if(aircraft.has_crashed())
         {
             terminal.abort_service();
-            m_reserved_terminals.erase(it);
-            aircraft.m_is_at_terminal = false;
+            m_reserved_terminals.erase(aircraft.get_handle());
+            aircraft.set(AircraftStore::at_terminal, false);
             return m_airport.start_path(terminal_num);
         }
         if (!terminal.is_servicing())
         {
             terminal.finish_service();
-            m_reserved_terminals.erase(it);
-            aircraft.m_is_at_terminal = false;
+            m_reserved_terminals.erase(aircraft.get_handle());
+            aircraft.set(AircraftStore::at_terminal, false);
             return m_airport.start_path(terminal_num);
         }
         else
@@ -56,23 +59,64 @@ WaypointQueue Tower::get_instructions(Aircraft& aircraft)
 
 void Tower::arrived_at_terminal(const Aircraft& aircraft)
 {
-    const auto it = m_reserved_terminals.find(&aircraft);
-    assert(it != m_reserved_terminals.end());
-    m_airport.get_terminal(it->second).start_service(aircraft);
+    const auto terminal_num = m_reserved_terminals.find(aircraft.get_handle());
+    assert(terminal_num != ReservationTable::NONE);
+    m_airport.get_terminal(terminal_num).start_service(aircraft);
+}
+
+void Tower::aircraft_crashed(const Aircraft& aircraft)
+{
+    const auto terminal_num = m_reserved_terminals.find(aircraft.get_handle());
+    if (terminal_num != ReservationTable::NONE)
+    {
+        m_airport.get_terminal(terminal_num).abort_service();
+        m_reserved_terminals.erase(aircraft.get_handle());
+    }
+    if (m_waiting.contains(aircraft.get_handle()))
+    {
+        m_waiting.remove(aircraft.get_handle());
+    }
 }
 
 WaypointQueue Tower::reserve_terminal(Aircraft& aircraft)
 {
+    // queued aircrafts have nothing to ask for while every terminal is taken
+    if (!m_airport.has_free_terminal() && m_waiting.contains(aircraft.get_handle()))
+    {
+        return {};
+    }
+
     // if the aircraft is far, then just guide it to the airport vicinity
     if (aircraft.distance_to(m_airport.m_pos) < 5)
     {
+        // aircrafts queue by fuel: only the most urgent one may take a free terminal
+        const auto handle = aircraft.get_handle();
+        if (!m_waiting.contains(handle))
+        {
+            m_waiting.push(handle, aircraft.get_unburnt_fuel());
+        }
+        if (m_waiting.top() != handle)
+        {
+            return {};
+        }
+
         // try and reserve a terminal for the craft to land
         const auto vp = m_airport.reserve_terminal(aircraft);
         if (!vp.first.empty())
         {
-            m_reserved_terminals.emplace(&aircraft, vp.second);
+            m_waiting.pop();
+            m_reserved_terminals.reserve(aircraft.get_handle(), vp.second);
             return vp.first;
         }
     }
     return {};
 }
+
+std::optional<AircraftStore::Handle> Tower::most_urgent_aircraft() const
+{
+    if (m_waiting.empty())
+    {
+        return std::nullopt;
+    }
+    return m_waiting.top();
+}
@@ -1,7 +1,10 @@
 #pragma once
 
-#include <map>
+#include <optional>
 
+#include "aircraft_store.hpp"
+#include "indexed_heap.hpp"
+#include "reservation_table.hpp"
 #include "waypoint.hpp"
 
 class Airport;
@@ -11,15 +14,20 @@ class Terminal;
 class Tower
 {
 private:
-    using AircraftToTerminal      = std::map<const Aircraft*, size_t>;
-    using AircraftAndTerminalIter = AircraftToTerminal::iterator;
-
     Airport& m_airport;
     // aircrafts may reserve a terminal
     // if so, we need to save the terminal number in order to liberate it when the craft leaves
-    AircraftToTerminal m_reserved_terminals = {};
-
-    WaypointQueue get_circle() const;
+    ReservationTable m_reserved_terminals = {};
+    // aircrafts close enough to land and waiting for a terminal, the one with the
+    // least fuel first (keyed by unburnt fuel, which does not change while circling)
+    IndexedHeap<double> m_waiting = {};
+
+    // holding patterns: squares around the airport, of HOLDING_SIZES sizes at
+    // HOLDING_LEVELS altitudes, so that the aircrafts waiting for a terminal do not all
+    // fly the same path (each aircraft keeps the one of its handle)
+    static constexpr size_t HOLDING_SIZES  = 8;
+    static constexpr size_t HOLDING_LEVELS = 8;
+    WaypointQueue get_circle(const Aircraft& aircraft) const;
 
 public:
     Tower(Airport& airport_) : m_airport { airport_ } {}
@@ -27,6 +35,10 @@ public:
     // produce instructions for aircraft
     WaypointQueue get_instructions(Aircraft& aircraft);
     void arrived_at_terminal(const Aircraft& aircraft);
+    // a crashed aircraft will never leave its terminal: free it now
+    void aircraft_crashed(const Aircraft& aircraft);
 
     WaypointQueue reserve_terminal(Aircraft& aircraft);
+    // the aircraft that will get the next free terminal, if any is waiting
+    std::optional<AircraftStore::Handle> most_urgent_aircraft() const;
 };
@@ -1,19 +1,140 @@
 #include "tower_sim.hpp"
 
+#include "GL/opengl_interface.hpp"
 #include "airport.hpp"
+#include "event_log.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string_view>
 
 using namespace std::string_literals;
 
-TowerSimulation::TowerSimulation(int argc, char** argv) :
-    m_help { (argc > 1) && (std::string { argv[1] } == "--help"s || std::string { argv[1] } == "-h"s) }
+TowerSimulation::TowerSimulation(int argc, char** argv)
 {
+    parse_args(argc, argv);
+
     MediaPath::initialize(argv[0]);
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
-    GL::init_gl(argc, argv, "Airport Tower Simulation");
+    std::srand(m_seed);
+    m_aircraft_factory.seed(m_seed);
+    m_aircraft_manager.get_flight_numbers().seed(m_seed);
+    // --help only prints the keys and the options
+    if (!GL::headless && !m_help)
+    {
+        GL::init_gl(argc, argv, "Airport Tower Simulation");
+    }
 
     create_keystrokes();
 }
 
+namespace {
+
+void print_usage(std::ostream& stream)
+{
+    stream << "options: --headless [--ticks N] [--aircraft N] --seed S --substeps N --max-catch-up N --threads N "
+              "--collisions --quiet --crashes-only --profile FILE"
+           << std::endl;
+}
+
+// the command line is wrong: nothing has started yet, there is nothing to clean up
+[[noreturn]] void usage_error(const std::string& message)
+{
+    std::cerr << "error: " << message << std::endl;
+    print_usage(std::cerr);
+    std::exit(EXIT_FAILURE);
+}
+
+}
+
+void TowerSimulation::parse_args(int argc, char** argv)
+{
+    // the value following the option at index i, as a whole unsigned number
+    const auto number = [argc, argv](int& i) {
+        const std::string option { argv[i] };
+        if (i + 1 >= argc)
+        {
+            usage_error(option + " needs a value");
+        }
+
+        const std::string_view text { argv[++i] };
+        unsigned int value = 0;
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (error != std::errc {} || end != text.data() + text.size())
+        {
+            usage_error("invalid value for " + option + ": " + std::string { text });
+        }
+        return value;
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg { argv[i] };
+        if (arg == "--help"s || arg == "-h"s)
+        {
+            m_help = true;
+        }
+        else if (arg == "--headless"s)
+        {
+            GL::headless = true;
+        }
+        else if (arg == "--ticks"s)
+        {
+            m_max_ticks = number(i);
+        }
+        else if (arg == "--aircraft"s)
+        {
+            m_initial_aircraft = number(i);
+        }
+        else if (arg == "--seed"s)
+        {
+            m_seed = number(i);
+        }
+        else if (arg == "--substeps"s)
+        {
+            // substeps per nominal display tick
+            GL::steps_per_sec = DEFAULT_TICKS_PER_SEC * std::max(1u, number(i));
+        }
+        else if (arg == "--threads"s)
+        {
+            m_aircraft_manager.set_num_threads(number(i));
+        }
+        else if (arg == "--quiet"s)
+        {
+            events::logger.set_verbosity(events::Verbosity::off);
+        }
+        else if (arg == "--crashes-only"s)
+        {
+            events::logger.set_verbosity(events::Verbosity::crashes);
+        }
+        else if (arg == "--collisions"s)
+        {
+            m_aircraft_manager.set_collisions(true);
+        }
+        else if (arg == "--profile"s)
+        {
+            if (i + 1 >= argc)
+            {
+                usage_error(arg + " needs a value");
+            }
+            m_profile_path = argv[++i];
+        }
+        else if (arg == "--max-catch-up"s)
+        {
+            GL::max_catch_up_ticks = number(i);
+        }
+        else
+        {
+            usage_error("unknown option " + arg);
+        }
+    }
+}
+
 TowerSimulation::~TowerSimulation()
 {
     delete m_airport;
@@ -22,7 +143,7 @@ TowerSimulation::~TowerSimulation()
 void TowerSimulation::create_random_aircraft()
 {
     assert(m_airport); // make sure the airport is initialized before creating aircraft
-    m_aircraft_manager.add_aircraft(m_aircraft_factory.create_random_aircraft(m_airport->get_tower()));
+    m_aircraft_manager.add_aircraft(m_aircraft_factory.create_random_aircraft(m_airport->get_tower(), m_aircraft_manager));
 }
 
 void TowerSimulation::create_keystrokes()
@@ -35,15 +156,24 @@ void TowerSimulation::create_keystrokes()
     GL::keystrokes.emplace('b', []() { GL::ticks_per_sec += 1; std::cout << "fps: " << GL::ticks_per_sec << std::endl; });
     GL::keystrokes.emplace('n', []() { if(GL::ticks_per_sec > 1) { GL::ticks_per_sec -= 1; std::cout << "fps: " << GL::ticks_per_sec << std::endl; } });
     GL::keystrokes.emplace('a', []() { GL::sim_speed += .1f; });
-    GL::keystrokes.emplace('e', []() { GL::sim_speed -= .1f; });
-    GL::keystrokes.emplace('m', [this]() { std::cout << m_aircraft_manager.count_crashed_aircrafts() << " aircrafts have crashed so far." << std::endl; });
+    // a negative speed would only pile up a debt of steps
+    GL::keystrokes.emplace('e', []() { GL::sim_speed = std::max(0.f, GL::sim_speed - .1f); });
+    GL::keystrokes.emplace('m', [this]() {
+        std::cout << m_aircraft_manager.count_crashed_aircrafts() << " aircrafts have crashed so far, "
+                  << m_aircraft_manager.count_near_misses() << " near misses, "
+                  << m_aircraft_manager.count_live_aircrafts() << " aircrafts alive (at most "
+                  << m_aircraft_manager.count_peak_aircrafts() << "): "
+                  << m_aircraft_manager.count_aircrafts_in_state(AircraftStore::State::incoming) << " incoming, "
+                  << m_aircraft_manager.count_aircrafts_in_state(AircraftStore::State::at_terminal) << " at terminals, "
+                  << m_aircraft_manager.count_aircrafts_in_state(AircraftStore::State::leaving) << " leaving." << std::endl;
+    });
     GL::keystrokes.emplace('h', [this]() { display_help(); });
+    GL::keystrokes.emplace('p', []() { profiling::profiler.print(std::cout); });
 
-    const auto& airlines = m_aircraft_factory.get_airlines();
-    for(size_t index = 0; index < airlines.size() ; ++index)
+    for(size_t index = 0; index < flights::AIRLINES.size() ; ++index)
     {
-        GL::keystrokes.emplace('0' + index, [this, airlines, index]() {
-            std::cout << "Airline " << airlines.at(index) << " is handling " << m_aircraft_manager.count_aircrafts_from_airline(airlines.at(index)) << " aircrafts." << std::endl;
+        GL::keystrokes.emplace('0' + index, [this, index]() {
+            std::cout << "Airline " << flights::AIRLINES[index] << " is handling " << m_aircraft_manager.count_aircrafts_from_airline(index) << " aircrafts." << std::endl;
         });
     }
 }
@@ -59,12 +189,27 @@ void TowerSimulation::display_help() const
     }
 
     std::cout << std::endl;
+
+    print_usage(std::cout);
 }
 
 void TowerSimulation::init_airport()
 {
-    m_airport = new Airport { one_lane_airport, Point3D { 0.f, 0.f, 0.f },
-                            new img::Image { one_lane_airport_sprite_path.get_full_path() }, m_aircraft_manager };
+    m_airport = new Airport { one_lane_airport, Point3D { 0.f, 0.f, 0.f }, &one_lane_airport_sprite_path,
+                              m_aircraft_manager };
+}
+
+void TowerSimulation::run_headless()
+{
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto ticks      = GL::headless_loop(m_max_ticks);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    events::logger.flush();
+
+    std::cout << "seed " << m_seed << ": " << ticks << " ticks in " << elapsed.count() << "s (" << ticks / elapsed.count() << " ticks/s), "
+              << m_aircraft_manager.count_crashed_aircrafts() << " aircrafts crashed, "
+              << m_aircraft_manager.count_near_misses() << " near misses, at most "
+              << m_aircraft_manager.count_peak_aircrafts() << " aircrafts alive." << std::endl;
 }
 
 void TowerSimulation::launch()
@@ -75,8 +220,28 @@ void TowerSimulation::launch()
         return;
     }
 
+    // the ring and the printing thread are set up before the first tick rather than in it
+    events::logger.start();
     init_airport();
     m_aircraft_factory.init_aircraft_types();
 
-    GL::loop();
+    for (unsigned int i = 0; i < m_initial_aircraft; ++i)
+    {
+        create_random_aircraft();
+    }
+
+    if (GL::headless)
+    {
+        run_headless();
+    }
+    else
+    {
+        GL::loop();
+    }
+
+    if (!m_profile_path.empty())
+    {
+        std::ofstream file { m_profile_path };
+        profiling::profiler.write_json(file);
+    }
 }
@@ -5,23 +5,36 @@ class Airport;
 #include "aircraft_manager.hpp"
 #include "aircraft_factory.hpp"
 
+#include <ctime>
+#include <string>
+
 class TowerSimulation
 {
 private:
     bool m_help        = false;
     Airport* m_airport = nullptr;
+    // --ticks and --aircraft, used to drive a --headless run
+    unsigned int m_max_ticks        = 0;
+    unsigned int m_initial_aircraft = 0;
+    // two runs with the same seed (and the same steps) are identical
+    unsigned int m_seed = static_cast<unsigned int>(std::time(nullptr));
+    // --profile: where the timings of the phases of a tick are written on exit
+    std::string m_profile_path;
     AircraftManager m_aircraft_manager;
     AircraftFactory m_aircraft_factory;
 
     TowerSimulation(const TowerSimulation&) = delete;
     TowerSimulation& operator=(const TowerSimulation&) = delete;
 
+    void parse_args(int argc, char** argv);
+
     void create_random_aircraft();
 
     void create_keystrokes();
     void display_help() const;
 
     void init_airport();
+    void run_headless();
 
 public:
     TowerSimulation(int argc, char** argv);
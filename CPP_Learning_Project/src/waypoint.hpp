@@ -1,8 +1,7 @@
 #pragma once
 
 #include "geometry.hpp"
-
-#include <deque>
+#include "inline_deque.hpp"
 
 enum WaypointType
 {
@@ -24,4 +23,5 @@ public:
     bool is_at_terminal() const { return type == wp_terminal; }
 };
 
-using WaypointQueue = std::deque<Waypoint>;
\ No newline at end of file
+// the longest path (terminal to air, through the gateway) has 6 waypoints
+using WaypointQueue = InlineDeque<Waypoint, 8>;
\ No newline at end of file